@@ -14,41 +14,725 @@ File History:
 
 #include "sched_sim.h"
 
-const int QUANTUM = 2;
+typedef struct simulationjob {			// Simulation job structure type - everything one algorithm needs to run on its own thread
 
-const int NUM_OF_ALGORITHMS = 5;
+	const Process *processes;			// Shared by every job; simulations only read the processes
+	int numOfProcesses;
+	int interval;
+	int numOfCpus;
+	bool asyncTrace;
+	bool binaryTrace;					// Whether the trace is encoded into trace rather than printed into output
+	bool latency;						// Whether the latency percentiles are printed after the results
+	const TraceSampling *sampling;
+	const char *cacheDir;				// Results are looked up here first, and added once simulated; NULL for no cache
+	unsigned long long workloadHash;
+	bool cacheHit;						// Whether the results came from the cache
+	Algorithm algo;
+	Info **summaries;
+	char *output;						// Everything printed for the algorithm, written to the output file once every algorithm is done
+	size_t outputSize;
+	char *trace;
+	size_t traceSize;
+
+} SimulationJob;
+
+typedef struct sweep {					// Sweep structure type - every setting of a parameter sweep, run in parallel over the same processes
+
+	const Process *processes;			// Shared by every setting; simulations only read the processes
+	int numOfProcesses;
+	int *quanta;						// Round robin is run once for every quantum
+	int numOfQuanta;
+	int *agingPeriods;					// Priority scheduling is run once for every aging period
+	int numOfAgingPeriods;
+	int numOfCpus;
+	const char *cacheDir;				// Settings already simulated are read from here; NULL for no cache
+	unsigned long long workloadHash;
+	Info **summaries;					// One for every setting, quanta first
+
+} Sweep;
+
+typedef struct whatif {					// What-if structure type - one change to one process, made part way through every simulation
+
+	const char *text;					// As given, to label the results
+	int time;							// Simulations are forked here
+	int ID;
+	int arrivalTime;					// Changed fields; INT_MIN leaves a field as it is
+	int burstTime;
+	int priority;
+
+} WhatIf;
+
+typedef struct whatifanalysis {			// What-if analysis structure type - every what-if, tried on every algorithm, the algorithms in parallel
+
+	const Process *processes;
+	int numOfProcesses;
+	WhatIf *whatIfs;					// In time order, so each algorithm's unchanged simulation only ever runs forward
+	int numOfWhatIfs;
+	Info **summaries;					// For every algorithm, the unchanged run and then one per what-if; NULL where the process had already arrived
+
+} WhatIfAnalysis;
+
+static Tracer* start_tracer(FILE *outFile, FILE *traceFile, int interval, bool asyncTrace, const TraceSampling *sampling, Algorithm algo)
+{
+	Tracer *tracer;
+
+	if(sampling->off || (traceFile == NULL && interval <= 0))							// Nothing would be written, so the simulation runs untraced
+		return NULL;
+
+	tracer = traceFile != NULL ? make_binary_tracer(traceFile, algo) : make_tracer(outFile, interval, asyncTrace);
+	sample_tracer(tracer, sampling);
+
+	return tracer;
+}
+
+static Info* run_algorithm(FILE *outFile, Tracer *tracer, const char *cacheDir, unsigned long long workloadHash, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config, bool *cacheHit)
+{
+	*cacheHit = false;
+
+	if(cacheDir != NULL && tracer == NULL)															// Traces are not cached, so traced runs are always simulated
+		return simulate_cached(outFile, cacheDir, workloadHash, processes, numOfProcesses, algo, config, cacheHit);
+
+	return simulate_config(outFile, tracer, processes, numOfProcesses, algo, config);
+}
+
+static void* run_simulation_job(void *arg)
+{
+	SimulationJob *job = (SimulationJob *) arg;
+	FILE *outFile = open_memstream(&job->output, &job->outputSize);							// Each algorithm prints into its own buffer
+	FILE *traceFile = job->binaryTrace ? open_memstream(&job->trace, &job->traceSize) : NULL;
+	SimConfig config;
+
+	Tracer *tracer = start_tracer(outFile, traceFile, job->interval, job->asyncTrace, job->sampling, job->algo);
+
+	init_sim_config(&config);
+	config.numOfCpus = job->numOfCpus;
+
+	job->summaries[job->algo] = run_algorithm(outFile, tracer, job->cacheDir, job->workloadHash, job->processes, job->numOfProcesses, job->algo, &config, &job->cacheHit);
+
+	if(tracer != NULL)
+		destroy_tracer(tracer);																// Trace is written out in full before the results
+	print_results(outFile, job->summaries, job->algo);
+
+	if(job->latency)
+	{
+		print_latency_stats(outFile, &job->summaries[job->algo]->latency);
+		fprintf(outFile, "\n\n");
+	}
+
+	fclose(outFile);
+	if(traceFile != NULL)
+		fclose(traceFile);
+
+	return NULL;
+}
+
+static int parse_int_list(const char *text, int **values)
+{
+	char *copy = strdup(text), *save, *item;
+	int count = 0, capacity = 16;
+
+	*values = (int *) malloc(sizeof(int) * capacity);
+
+	for(item = strtok_r(copy, ",", &save); item != NULL; item = strtok_r(NULL, ",", &save))	// Comma separated numbers or ranges; FIRST-LAST or FIRST-LAST:STEP
+	{
+		int first, last, step = 1, fields = sscanf(item, "%d-%d:%d", &first, &last, &step);
+
+		if(fields == 1)
+			last = first;
+
+		if(fields < 1 || first < 1 || last < first || step < 1)
+		{
+			count = -1;
+			break;
+		}
+
+		for(int value = first; value <= last; value += step)
+		{
+			if(count == capacity)
+			{
+				capacity *= 2;
+				*values = (int *) realloc(*values, sizeof(int) * capacity);
+			}
+
+			(*values)[count++] = value;
+		}
+	}
+
+	free(copy);
+
+	return count;
+}
+
+static bool parse_what_if(const char *text, WhatIf *whatIf)
+{
+	char *copy, *save, *setting;
+	int length = 0;
+	bool valid;
+
+	whatIf->text = text;
+	whatIf->arrivalTime = whatIf->burstTime = whatIf->priority = INT_MIN;
+
+	if(sscanf(text, "%d:%d:%n", &whatIf->time, &whatIf->ID, &length) < 2 || length == 0 || whatIf->time < 0 || whatIf->ID < 0)	// TIME:PID:FIELD=VALUE[,FIELD=VALUE...]
+		return false;
+
+	copy = strdup(text + length);
+	valid = copy[0] != '\0';
+
+	for(setting = strtok_r(copy, ",", &save); setting != NULL && valid; setting = strtok_r(NULL, ",", &save))
+	{
+		if(sscanf(setting, "arrival=%d", &whatIf->arrivalTime) == 1)
+			valid = whatIf->arrivalTime >= 0;
+		else if(sscanf(setting, "burst=%d", &whatIf->burstTime) == 1)
+			valid = whatIf->burstTime > 0;
+		else
+			valid = sscanf(setting, "priority=%d", &whatIf->priority) == 1;
+	}
+
+	free(copy);
+
+	return valid;
+}
+
+static void run_what_if_job(void *context, int job)
+{
+	WhatIfAnalysis *analysis = (WhatIfAnalysis *) context;
+	Info **summaries = &analysis->summaries[job * (analysis->numOfWhatIfs + 1)];
+	Process *changed = (Process *) malloc(sizeof(Process) * (analysis->numOfProcesses + 1));
+	Simulation *sim;
+	SimConfig config;
+
+	init_sim_config(&config);
+	sim = start_simulation(analysis->processes, analysis->numOfProcesses, job, &config);
+
+	for(int i = 0; i < analysis->numOfWhatIfs; i++)										// Only the part after each change is simulated again
+	{
+		WhatIf *whatIf = &analysis->whatIfs[i];
+		Process *process = &changed[whatIf->ID];
+		Simulation *fork;
+
+		run_simulation(sim, whatIf->time);
+		memcpy(changed, analysis->processes, sizeof(Process) * analysis->numOfProcesses);
+
+		if(whatIf->arrivalTime != INT_MIN)
+			process->arrivalTime = whatIf->arrivalTime;
+		if(whatIf->burstTime != INT_MIN)
+			process->burstTime = whatIf->burstTime;
+		if(whatIf->priority != INT_MIN)
+			process->priority = whatIf->priority;
+
+		fork = fork_simulation(sim, changed);
+		summaries[i + 1] = fork != NULL ? finish_simulation(fork) : NULL;
+	}
+
+	summaries[0] = finish_simulation(sim);
+	free(changed);
+}
+
+static void print_what_if_results(FILE *outFile, WhatIfAnalysis *analysis)
+{
+	fprintf(outFile, "***** WHAT-IF ANALYSIS *****\n\n");
+	fprintf(outFile, "%-12s %-28s %12s %12s %17s\n", "Algorithm", "Change", "Avg WT", "Avg TT", "Context Switches");
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+	{
+		for(int j = 0; j <= analysis->numOfWhatIfs; j++)								// The unchanged run first, to compare against
+		{
+			Info *summary = analysis->summaries[i * (analysis->numOfWhatIfs + 1) + j];
+
+			fprintf(outFile, "%-12s %-28s", algorithm_name(i), j == 0 ? "None" : analysis->whatIfs[j - 1].text);
+
+			if(summary == NULL)
+				fprintf(outFile, " Process %d has already arrived\n", analysis->whatIfs[j - 1].ID);
+			else
+				fprintf(outFile, " %12.2f %12.2f %17d\n", summary->avgWaitTime, summary->avgTurnaroundTime, summary->contextSwitches);
+		}
+	}
+}
+
+static void run_sweep_job(void *context, int job)
+{
+	Sweep *sweep = (Sweep *) context;
+	SimConfig config;
+	bool cacheHit;
+
+	init_sim_config(&config);
+	config.numOfCpus = sweep->numOfCpus;
+
+	if(job < sweep->numOfQuanta)
+	{
+		config.quantum = sweep->quanta[job];
+		sweep->summaries[job] = run_algorithm(NULL, NULL, sweep->cacheDir, sweep->workloadHash, sweep->processes, sweep->numOfProcesses, RR, &config, &cacheHit);	// Only the results are kept
+	}
+	else
+	{
+		config.agingPeriod = sweep->agingPeriods[job - sweep->numOfQuanta];
+		sweep->summaries[job] = run_algorithm(NULL, NULL, sweep->cacheDir, sweep->workloadHash, sweep->processes, sweep->numOfProcesses, NPP, &config, &cacheHit);
+	}
+}
+
+static void print_sweep_results(FILE *outFile, Sweep *sweep)
+{
+	fprintf(outFile, "***** PARAMETER SWEEP *****\n\n");
+	fprintf(outFile, "%-12s %-14s %12s %12s %17s\n", "Algorithm", "Setting", "Avg WT", "Avg TT", "Context Switches");
+
+	for(int i = 0; i < sweep->numOfQuanta + sweep->numOfAgingPeriods; i++)				// Settings in the order they were given
+	{
+		Info *summary = sweep->summaries[i];
+
+		if(i < sweep->numOfQuanta)
+			fprintf(outFile, "%-12s Quantum = %-4d", algorithm_name(RR), sweep->quanta[i]);
+		else
+			fprintf(outFile, "%-12s Aging = %-6d", algorithm_name(NPP), sweep->agingPeriods[i - sweep->numOfQuanta]);
+
+		fprintf(outFile, " %12.2f %12.2f %17d\n", summary->avgWaitTime, summary->avgTurnaroundTime, summary->contextSwitches);
+	}
+}
 
 int main(int argc, char* argv[])
 {
-	FILE *inFile, *outFile;
-	int numOfProcesses, interval;
+	FILE *outFile, *traceFile = NULL;
+	char *traceFileName = NULL, *ganttFileName = NULL, *workloadText = NULL, *quantaText = NULL, *agingText = NULL, *batchInputs = NULL, *cacheDir = NULL, *socketPath = NULL;
+	unsigned long long workloadHash = 0;
+	int numOfProcesses, interval, option, fileArgs, numOfThreads = default_thread_count(), numOfCpus = 1, reportPeriod = -1, numOfWhatIfs = 0;
+	bool verbose = false, parallel = false, asyncTrace = false, latency = false, sampled = false;
 	Process *processes;
+	ParseStats parseStats;
+	WorkloadSpec workload;
+	TraceSampling sampling;
+	WhatIf *whatIfs = NULL;
 	Info **summaries = (Info **) malloc(sizeof(Info *) * NUM_OF_ALGORITHMS);
+	bool cacheHits[NUM_OF_ALGORITHMS];
+
+	init_trace_sampling(&sampling);
 
-	if (argc < 4)																		// Simple detection if not enough command line arguments were sent
+	while((option = getopt(argc, argv, "A:aB:b:C:c:f:g:j:lpq:S:s:t:vw:")) != -1)										// Optional flags may be given alongside the file names and interval
+	{
+		switch(option)
+		{
+			case 'A':
+				agingText = optarg;														// Sweep the priority scheduling aging period over these values
+				break;
+
+			case 'a':
+				asyncTrace = true;														// Format and write the trace from a background thread
+				break;
+
+			case 'B':
+				batchInputs = optarg;													// Simulate every file of a directory or manifest
+				break;
+
+			case 'b':
+				traceFileName = optarg;													// Write every event to a binary trace instead of printing intervals
+				break;
+
+			case 'C':
+				cacheDir = optarg;														// Reuse results already simulated for the same processes and settings
+				break;
+
+			case 'c':
+				numOfCpus = MAX(atoi(optarg), 1);										// CPUs to simulate, each with its own ready queue
+				break;
+
+			case 'f':
+			{
+				WhatIf whatIf;
+				int i = numOfWhatIfs++;
+
+				if(!parse_what_if(optarg, &whatIf))
+				{
+					printf("ERROR: Invalid what-if %s.\n", optarg);
+					return 0;
+				}
+
+				whatIfs = (WhatIf *) realloc(whatIfs, sizeof(WhatIf) * numOfWhatIfs);
+				for(; i > 0 && whatIfs[i - 1].time > whatIf.time; i--)					// Kept in time order; what-ifs at the same time stay in the order given
+					whatIfs[i] = whatIfs[i - 1];
+				whatIfs[i] = whatIf;
+				break;
+			}
+
+			case 'g':
+				ganttFileName = optarg;													// Write when each process held the CPU for every algorithm
+				break;
+
+			case 'j':
+				numOfThreads = MAX(atoi(optarg), 1);									// Threads a sweep runs on
+				break;
+
+			case 'l':
+				latency = true;															// Print the wait, turnaround and response time percentiles of every algorithm
+				break;
+
+			case 'p':
+				parallel = true;														// Run every algorithm at the same time on its own thread
+				break;
+
+			case 'q':
+				quantaText = optarg;													// Sweep the round robin quantum over these values
+				break;
+
+			case 'S':
+				socketPath = optarg;													// Serve simulation requests on this Unix domain socket ("-" for standard input and output)
+				break;
+
+			case 's':
+				reportPeriod = MAX(atoi(optarg), 0);									// Simulate while reading the input, reporting running averages every this many ticks
+				break;
+
+			case 't':
+				if(!parse_trace_sampling(optarg, &sampling))							// Keep only part of the trace; off, every=N, changes or window=FROM:TO
+				{
+					printf("ERROR: Invalid trace sampling %s.\n", optarg);
+					return 0;
+				}
+				sampled = true;
+				break;
+
+			case 'v':
+				verbose = true;															// Report run statistics on stderr
+				break;
+
+			case 'w':
+				workloadText = optarg;													// Generate the processes in memory instead of reading an input file
+				break;
+
+			default:
+				printf("Usage: %s [-alpv] [-c <cpus>] [-C <cache dir>] [-b <trace file>] [-t <trace sampling>] [-g <timeline file>] <input file> <output file> <interval>\n", argv[0]);
+				printf("       %s [-alpv] [-c <cpus>] [-C <cache dir>] [-b <trace file>] [-t <trace sampling>] [-g <timeline file>] -w <workload spec> <output file> <interval>\n", argv[0]);
+				printf("       %s [-v] [-j <threads>] -B <input directory or manifest> <output directory> <interval>\n", argv[0]);
+				printf("       %s [-v] [-j <threads>] -S <socket path or ->\n", argv[0]);
+				printf("       %s [-v] -s <report period> [-w <workload spec> | <input file>] <output file>\n", argv[0]);
+				printf("       %s [-q <quanta>] [-A <aging periods>] [-c <cpus>] [-C <cache dir>] [-j <threads>] [-w <workload spec> | <input file>] <output file>\n", argv[0]);
+				printf("       %s [-j <threads>] -f <time>:<pid>:<field>=<value>[,...] [-f ...] [-w <workload spec> | <input file>] <output file>\n", argv[0]);
+				return 0;
+		}
+	}
+
+	if(socketPath != NULL)																// Server mode: requests are read and answered until interrupted; no files are given
+	{
+		free(summaries);
+
+		if(strcmp(socketPath, "-") == 0)												// A single client on standard input and output
+		{
+			SimContext *context = make_sim_context();
+			int requests = serve_connection(stdin, stdout, context);
+
+			if(verbose)
+				fprintf(stderr, "Served %d requests\n", requests);
+
+			destroy_sim_context(context);
+		}
+		else if(run_server(socketPath, numOfThreads, verbose) != 0)
+			printf("ERROR: Unable to serve on socket %s.\n", socketPath);
+
+		return 0;
+	}
+
+	if(batchInputs != NULL)																// Batch mode: the output file is a directory for every input's output and the summary
+	{
+		int numOfFailed;
+
+		if(argc - optind < 2)
+		{
+			printf("ERROR: Incorrect amount of command line inputs.\n");
+			return 0;
+		}
+
+		if((numOfFailed = run_batch(batchInputs, argv[optind], atoi(argv[optind + 1]), numOfThreads, verbose)) < 0)
+			printf("ERROR: Unable to read inputs %s or write to %s.\n", batchInputs, argv[optind]);
+		else if(numOfFailed > 0)
+			printf("WARNING: %d input files could not be read.\n", numOfFailed);
+
+		free(summaries);
+
+		return 0;
+	}
+
+	fileArgs = (workloadText != NULL ? 2 : 3) - (quantaText != NULL || agingText != NULL || reportPeriod >= 0 || numOfWhatIfs > 0);	// A generated workload takes the place of the input file; Sweeps, streams and what-ifs have no trace to print
+
+	if (argc - optind < fileArgs)														// Simple detection if not enough command line arguments were sent
 	{
 		printf("ERROR: Incorrect amount of command line inputs.\n");
 		return 0;
 	}
 
-	inFile = fopen(argv[1], "r");														// Open input file for reading
-	outFile = fopen(argv[2], "w");														// Open output file for writing
-	interval = atoi(argv[3]);															// Convert last argument to integer to determine interval in which to print the simulation
+	if(numOfCpus > 1 && (traceFileName != NULL || (sampled && !sampling.off)))			// Multi-CPU runs are never traced, so a trace file would only hold the titles; "-t off" asks for none
+	{
+		printf("ERROR: Traces are only written for a single CPU; use -g for the timeline of every CPU.\n");
+		return 0;
+	}
+
+	if(reportPeriod >= 0)																// Streaming mode: processes are simulated as they are read and released once finished
+	{
+		struct timespec start;
+		SimConfig config;
+		Stream *stream;
+		long long numStreamed = 0;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		init_sim_config(&config);
+
+		if(workloadText != NULL)
+		{
+			init_workload_spec(&workload, 1000, 1);
+
+			if(!parse_workload_spec(workloadText, &workload))
+			{
+				printf("ERROR: Unable to generate workload %s.\n", workloadText);
+				return 0;
+			}
+		}
+
+		if((outFile = fopen(argv[optind + fileArgs - 1], "w")) == NULL)
+		{
+			printf("ERROR: Unable to write output file %s.\n", argv[optind + fileArgs - 1]);
+			return 0;
+		}
+
+		stream = make_stream(outFile, reportPeriod, &config);
+
+		if(workloadText != NULL)														// Generated processes are never all held at once either
+		{
+			WorkloadGenerator generator;
+			Process process;
+
+			init_workload_generator(&generator, &workload);
+			while(next_generated_process(&generator, &process))
+				stream_process(stream, &process);
 
-	numOfProcesses = find_num_of_processes(inFile);										// Find how many processes are detailed in the input file
+			numStreamed = stream->numOfProcesses;
+		}
+		else
+			numStreamed = stream_file(stream, argv[optind]);
 
-	processes =	load_processes(inFile, numOfProcesses);									// Load processes' information from input file and store in array of process objects
+		if(numStreamed == -1)
+			printf("ERROR: Unable to read input file %s.\n", argv[optind]);
+		else if(numStreamed == -2)
+			printf("ERROR: Input file %s is not in arrival order; process %lld arrives too early.\n", argv[optind], stream->numOfProcesses);
+		else
+		{
+			finish_stream(stream);
+
+			if(verbose)																	// Report the throughput of the stream
+				fprintf(stderr, "Streamed %lld processes in %.3f s, %.0f processes/s\n", numStreamed, elapsed_seconds(&start), numStreamed / MAX(elapsed_seconds(&start), 1e-9));
+		}
+
+		destroy_stream(stream);
+		fclose(outFile);
+		free(summaries);
+
+		return 0;
+	}
+
+	if(workloadText != NULL)
+	{
+		struct timespec start;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		init_workload_spec(&workload, 1000, 1);											// Anything the spec leaves out keeps its default
+
+		if(!parse_workload_spec(workloadText, &workload) || (processes = generate_processes(&workload, &numOfProcesses)) == NULL)
+		{
+			printf("ERROR: Unable to generate workload %s.\n", workloadText);
+			return 0;
+		}
+
+		if(verbose)																		// Report how fast the workload was generated
+			fprintf(stderr, "Generated %d processes in %.3f s\n", numOfProcesses, elapsed_seconds(&start));
+	}
+	else
+	{
+		processes = load_processes(argv[optind], &numOfProcesses, &parseStats);			// Load processes' information from input file and store in array of process objects
+
+		if(processes == NULL)
+		{
+			printf("ERROR: Unable to read input file %s.\n", argv[optind]);
+			return 0;
+		}
+	}
+
+	if(verbose && workloadText == NULL)																			// Report how fast the input was parsed
+		fprintf(stderr, "Parsed %d processes (%lld bytes) in %.3f s, %.1f MB/s\n", numOfProcesses, parseStats.bytes, parseStats.seconds, parseStats.bytes / 1e6 / MAX(parseStats.seconds, 1e-9));
+
+	if(cacheDir != NULL)																// Hashed once; every algorithm and setting derives its key from it
+		workloadHash = hash_workload(processes, numOfProcesses);
+
+	if(numOfWhatIfs > 0)																// What-if mode: every algorithm is forked part way through for every change
+	{
+		WhatIfAnalysis analysis = { processes, numOfProcesses, whatIfs, numOfWhatIfs, NULL };
+
+		if(numOfCpus > 1)
+		{
+			printf("ERROR: What-if analysis simulates a single CPU.\n");
+			return 0;
+		}
+
+		for(int i = 0; i < numOfWhatIfs; i++)
+		{
+			if(whatIfs[i].ID >= numOfProcesses)
+			{
+				printf("ERROR: What-if %s changes a process that does not exist.\n", whatIfs[i].text);
+				return 0;
+			}
+		}
+
+		analysis.summaries = (Info **) malloc(sizeof(Info *) * NUM_OF_ALGORITHMS * (numOfWhatIfs + 1));
+		run_parallel(NUM_OF_ALGORITHMS, numOfThreads, run_what_if_job, &analysis);
+
+		outFile = fopen(argv[optind + fileArgs - 1], "w");
+		print_what_if_results(outFile, &analysis);
+		fclose(outFile);
+
+		for(int i = 0; i < NUM_OF_ALGORITHMS * (numOfWhatIfs + 1); i++)
+		{
+			if(analysis.summaries[i] != NULL)
+				destroy_info(analysis.summaries[i]);
+		}
+		free(analysis.summaries);
+		free(whatIfs);
+		free(processes);
+		free(summaries);
+
+		return 0;
+	}
+
+	if(quantaText != NULL || agingText != NULL)										// Sweep mode: only the table of results for every setting is printed
+	{
+		Sweep sweep = { processes, numOfProcesses, NULL, 0, NULL, 0, numOfCpus, cacheDir, workloadHash, NULL };
+
+		if((quantaText != NULL && (sweep.numOfQuanta = parse_int_list(quantaText, &sweep.quanta)) < 0) ||
+		   (agingText != NULL && (sweep.numOfAgingPeriods = parse_int_list(agingText, &sweep.agingPeriods)) < 0))
+		{
+			printf("ERROR: Invalid sweep values.\n");
+			return 0;
+		}
+
+		sweep.summaries = (Info **) malloc(sizeof(Info *) * (sweep.numOfQuanta + sweep.numOfAgingPeriods));
+		run_parallel(sweep.numOfQuanta + sweep.numOfAgingPeriods, numOfThreads, run_sweep_job, &sweep);
+
+		outFile = fopen(argv[optind + fileArgs - 1], "w");
+		print_sweep_results(outFile, &sweep);
+		fclose(outFile);
+
+		for(int i = 0; i < sweep.numOfQuanta + sweep.numOfAgingPeriods; i++)
+			destroy_info(sweep.summaries[i]);
+		free(sweep.summaries);
+		free(sweep.quanta);
+		free(sweep.agingPeriods);
+		free(processes);
+		free(summaries);
+
+		return 0;
+	}
+
+	outFile = fopen(argv[optind + fileArgs - 2], "w");										// Open output file for writing
+	interval = atoi(argv[optind + fileArgs - 1]);													// Convert last argument to integer to determine interval in which to print the simulation
+
+	if(traceFileName != NULL && (traceFile = fopen(traceFileName, "wb")) == NULL)
+	{
+		printf("ERROR: Unable to write trace file %s.\n", traceFileName);
+		return 0;
+	}
+
+	if(parallel)
+	{
+		SimulationJob *jobs = (SimulationJob *) malloc(sizeof(SimulationJob) * NUM_OF_ALGORITHMS);
+		pthread_t *threads = (pthread_t *) malloc(sizeof(pthread_t) * NUM_OF_ALGORITHMS);
+
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)										// Start one thread per algorithm, all sharing the same processes
+		{
+			jobs[i].processes = processes;
+			jobs[i].numOfProcesses = numOfProcesses;
+			jobs[i].interval = interval;
+			jobs[i].numOfCpus = numOfCpus;
+			jobs[i].asyncTrace = asyncTrace;
+			jobs[i].binaryTrace = traceFile != NULL;
+			jobs[i].latency = latency;
+			jobs[i].sampling = &sampling;
+			jobs[i].cacheDir = cacheDir;
+			jobs[i].workloadHash = workloadHash;
+			jobs[i].algo = i;
+			jobs[i].summaries = summaries;
+			pthread_create(&threads[i], NULL, run_simulation_job, &jobs[i]);
+		}
+
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)										// Write the results out in the usual order as the threads finish
+		{
+			pthread_join(threads[i], NULL);
+			fwrite(jobs[i].output, 1, jobs[i].outputSize, outFile);
+			cacheHits[i] = jobs[i].cacheHit;
+
+			if(traceFile != NULL)
+			{
+				fwrite(jobs[i].trace, 1, jobs[i].traceSize, traceFile);
+				free(jobs[i].trace);
+			}
+
+			free(jobs[i].output);
+		}
+
+		free(jobs);
+		free(threads);
+	}
 
 	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
 	{
-		summaries[i] = simulate(outFile, interval, processes, numOfProcesses, i);		// Simulate first-come-first-served (FCFS) algorithm
-		print_results(outFile, processes, numOfProcesses, summaries, i);				// Print FCFS results
+		if(!parallel)
+		{
+			Tracer *tracer = start_tracer(outFile, traceFile, interval, asyncTrace, &sampling, i);	// Prints the simulation every interval ticks
+			SimConfig config;
+
+			init_sim_config(&config);
+			config.numOfCpus = numOfCpus;
+
+			summaries[i] = run_algorithm(outFile, tracer, cacheDir, workloadHash, processes, numOfProcesses, i, &config, &cacheHits[i]);	// Simulate first-come-first-served (FCFS) algorithm
+
+			if(tracer != NULL)
+				destroy_tracer(tracer);													// Trace is written out in full before the results
+			print_results(outFile, summaries, i);										// Print FCFS results
+
+			if(latency)																	// Tail latencies, after the usual results
+			{
+				print_latency_stats(outFile, &summaries[i]->latency);
+				fprintf(outFile, "\n\n");
+			}
+		}
+
+		if(verbose)																		// Confirm the simulation loop itself did not have to allocate memory per node
+		{
+			fprintf(stderr, "%s: %lld ready queue nodes used, %lld memory allocations\n", algorithm_name(i), summaries[i]->nodeRequests, summaries[i]->allocations);
+
+			if(cacheDir != NULL)
+				fprintf(stderr, "%s: results %s\n", algorithm_name(i), cacheHits[i] ? "taken from the cache" : "simulated");
+		}
+
+		INSTRUMENT(print_instrumentation(stderr, summaries[i], i);)						// Instrumented builds always report, on stderr so the output file is unchanged
 	}
 
 	print_overall_results(outFile, summaries);											// Sort and print results from all algorithms
+
+	if(ganttFileName != NULL)
+	{
+		FILE *ganttFile = fopen(ganttFileName, "w");
+
+		if(ganttFile == NULL)
+			printf("ERROR: Unable to write timeline file %s.\n", ganttFileName);
+		else
+		{
+			for(int i = 0; i < NUM_OF_ALGORITHMS; i++)									// Same intervals the process sequences are printed from
+			{
+				fprintf(ganttFile, "***** %s Timeline *****\n", algorithm_name(i));
+				print_gantt_chart(ganttFile, summaries[i]->processSequence);
+				fprintf(ganttFile, "\n");
+			}
+
+			fclose(ganttFile);
+		}
+	}
 	
-	fclose(inFile);																		// Close the files
-	fclose(outFile);
+	fclose(outFile);																	// Close the output file
+	if(traceFile != NULL)
+		fclose(traceFile);
 
 	free(processes);																	// Destroy/deallocate memory for array of process objects in order to avoid memory leaks
 
@@ -0,0 +1,403 @@
+/*************************************************************************************
+File Name: sched_batch.c
+
+Objective: Provide batch mode, which simulates every input file of a directory or
+		   manifest over a thread pool and summarizes the results of them all
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+static int compare_names(const void *a, const void *b)
+{
+	return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+static char* join_path(const char *directory, const char *name)
+{
+	char *path = (char *) malloc(strlen(directory) + strlen(name) + 2);
+
+	sprintf(path, "%s/%s", directory, name);
+
+	return path;
+}
+
+static int list_inputs(const char *inputs, char ***names)
+{
+	struct stat info;
+	int count = 0, capacity = 64;
+
+	*names = (char **) malloc(sizeof(char *) * capacity);
+
+	if(stat(inputs, &info) != 0)
+		return -1;
+
+	if(S_ISDIR(info.st_mode))												// Every regular file of the directory, in name order so runs are repeatable
+	{
+		DIR *directory = opendir(inputs);
+		struct dirent *entry;
+
+		if(directory == NULL)
+			return -1;
+
+		while((entry = readdir(directory)) != NULL)
+		{
+			char *path;
+
+			if(entry->d_name[0] == '.')
+				continue;
+
+			path = join_path(inputs, entry->d_name);
+
+			if(stat(path, &info) != 0 || !S_ISREG(info.st_mode))
+			{
+				free(path);
+				continue;
+			}
+
+			if(count == capacity)
+			{
+				capacity *= 2;
+				*names = (char **) realloc(*names, sizeof(char *) * capacity);
+			}
+
+			(*names)[count++] = path;
+		}
+
+		closedir(directory);
+		qsort(*names, count, sizeof(char *), compare_names);
+	}
+	else																	// A manifest: one input file per line; blank lines and lines starting with # are skipped
+	{
+		FILE *manifest = fopen(inputs, "r");
+		char line[4096];
+
+		if(manifest == NULL)
+			return -1;
+
+		while(fgets(line, sizeof(line), manifest) != NULL)
+		{
+			size_t length = strlen(line);
+
+			while(length > 0 && isspace((unsigned char) line[length - 1]))
+				line[--length] = '\0';
+
+			if(length == 0 || line[0] == '#')
+				continue;
+
+			if(count == capacity)
+			{
+				capacity *= 2;
+				*names = (char **) realloc(*names, sizeof(char *) * capacity);
+			}
+
+			(*names)[count++] = strdup(line);
+		}
+
+		fclose(manifest);
+	}
+
+	return count;
+}
+
+static int compare_outputs(const void *a, const void *b)
+{
+	char **x = *(char ** const *) a, **y = *(char ** const *) b;
+	int order = strcmp(*x, *y);
+
+	return order != 0 ? order : (x > y) - (x < y);							// Equal names stay in input order
+}
+
+static char* rename_output(const char *inputName, const char *outputName, int pass, int f)
+{
+	char *name = (char *) malloc(strlen(inputName) + strlen(outputName) + 16);
+
+	if(pass == 0)															// First the whole path, with every / as _
+	{
+		char *c;
+
+		while(inputName[0] == '/' || strncmp(inputName, "./", 2) == 0)
+			inputName += inputName[0] == '/' ? 1 : 2;
+
+		sprintf(name, "%s.out", inputName);
+		for(c = name; (c = strchr(c, '/')) != NULL; c++)
+			*c = '_';
+	}
+	else																	// Then, for the same file listed twice, its place in the list
+		sprintf(name, "%.*s.%d.out", (int) strlen(outputName) - 4, outputName, f + 1);
+
+	return name;
+}
+
+static char** name_outputs(char **names, int count)
+{
+	char **outputs = (char **) malloc(sizeof(char *) * MAX(count, 1));
+	char ***order = (char ***) malloc(sizeof(char **) * MAX(count, 1));
+	bool *clashes = (bool *) malloc(sizeof(bool) * MAX(count, 1));
+	bool renamed = true;
+
+	for(int f = 0; f < count; f++)											// Outputs are named after their inputs
+	{
+		const char *baseName = strrchr(names[f], '/') != NULL ? strrchr(names[f], '/') + 1 : names[f];
+
+		outputs[f] = (char *) malloc(strlen(baseName) + 5);
+		sprintf(outputs[f], "%s.out", baseName);
+		order[f] = &outputs[f];
+	}
+
+	for(int pass = 0; renamed; pass++)										// Until no two inputs share an output; otherwise their threads would write the same file
+	{
+		renamed = false;
+		memset(clashes, 0, sizeof(bool) * count);
+		qsort(order, count, sizeof(char **), compare_outputs);
+
+		for(int i = 1; i < count; i++)
+		{
+			if(strcmp(*order[i], *order[i - 1]) == 0)
+				clashes[order[i] - outputs] = clashes[order[i - 1] - outputs] = true;
+		}
+
+		for(int i = 0; i < count; i++)
+		{
+			int f = order[i] - outputs;
+
+			if(clashes[f] && (pass == 0 || (i > 0 && strcmp(*order[i], *order[i - 1]) == 0)))	// Past the first pass the first of each clash keeps its name
+			{
+				char *name = rename_output(names[f], outputs[f], pass, f);
+
+				free(outputs[f]);
+				outputs[f] = name;
+				renamed = true;
+			}
+		}
+	}
+
+	free(order);
+	free(clashes);
+
+	return outputs;
+}
+
+static void finish_batch_file(BatchFile *file)
+{
+	FILE *outFile;
+
+	if(!file->failed && (outFile = fopen(file->outputName, "w")) != NULL)	// Same output Project3 writes for the file on its own
+	{
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+			fwrite(file->outputs[i], 1, file->outputSizes[i], outFile);
+
+		print_overall_results(outFile, file->summaries);
+		fclose(outFile);
+	}
+	else
+		file->failed = true;
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)								// Only the averages are kept for the summary
+	{
+		if(file->summaries[i] != NULL)
+		{
+			file->avgWaitTimes[i] = file->summaries[i]->avgWaitTime;
+			file->avgTurnaroundTimes[i] = file->summaries[i]->avgTurnaroundTime;
+			file->contextSwitches[i] = file->summaries[i]->contextSwitches;
+			destroy_info(file->summaries[i]);
+		}
+
+		free(file->outputs[i]);
+	}
+
+	free(file->processes);
+	free(file->summaries);
+	free(file->outputs);
+	free(file->outputSizes);
+
+	file->processes = NULL;
+	file->summaries = NULL;
+	file->outputs = NULL;
+	file->outputSizes = NULL;
+}
+
+static void run_batch_job(void *context, int job)
+{
+	Batch *batch = (Batch *) context;
+	BatchFile *file = &batch->files[job / NUM_OF_ALGORITHMS];				// Jobs are numbered file by file, one for every algorithm
+	Algorithm algo = job % NUM_OF_ALGORITHMS;
+	bool last;
+
+	pthread_mutex_lock(&file->lock);
+	if(!file->loaded)														// The file's other jobs wait here until it is loaded
+	{
+		file->processes = load_processes(file->inputName, &file->numOfProcesses, NULL);
+		file->failed = file->processes == NULL || file->numOfProcesses == 0;
+		file->loaded = true;
+	}
+	pthread_mutex_unlock(&file->lock);
+
+	if(!file->failed)
+	{
+		FILE *outFile = open_memstream(&file->outputs[algo], &file->outputSizes[algo]);	// Each algorithm prints into its own buffer
+		Tracer *tracer = make_tracer(outFile, batch->interval, false);
+
+		file->summaries[algo] = simulate(outFile, tracer, file->processes, file->numOfProcesses, algo);
+		destroy_tracer(tracer);
+		print_results(outFile, file->summaries, algo);
+
+		fclose(outFile);
+	}
+
+	pthread_mutex_lock(&file->lock);
+	last = --file->jobsLeft == 0;
+	pthread_mutex_unlock(&file->lock);
+
+	if(last)																// Every algorithm is done, so the output can be written and the memory freed
+		finish_batch_file(file);
+}
+
+static void print_batch_summary(FILE *outFile, Batch *batch)
+{
+	double *totalWaitTimes = (double *) calloc(NUM_OF_ALGORITHMS, sizeof(double));
+	double *totalTurnaroundTimes = (double *) calloc(NUM_OF_ALGORITHMS, sizeof(double));
+	long long *totalContextSwitches = (long long *) calloc(NUM_OF_ALGORITHMS, sizeof(long long));
+	long long numOfProcesses = 0;
+	int numOfFailed = 0;
+
+	for(int f = 0; f < batch->numOfFiles; f++)
+	{
+		BatchFile *file = &batch->files[f];
+
+		if(file->failed)
+		{
+			numOfFailed++;
+			continue;
+		}
+
+		numOfProcesses += file->numOfProcesses;
+
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)							// Totals weighted by the number of processes of each file
+		{
+			totalWaitTimes[i] += file->avgWaitTimes[i] * file->numOfProcesses;
+			totalTurnaroundTimes[i] += file->avgTurnaroundTimes[i] * file->numOfProcesses;
+			totalContextSwitches[i] += file->contextSwitches[i];
+		}
+	}
+
+	fprintf(outFile, "***** BATCH SUMMARY *****\n\n");
+	fprintf(outFile, "Files: %d (%d unreadable)\n", batch->numOfFiles, numOfFailed);
+	fprintf(outFile, "Processes: %lld\n\n", numOfProcesses);
+
+	fprintf(outFile, "Overall (WT and TT averaged over every process)\n");
+	fprintf(outFile, "Algorithm\tAvg WT\t\tAvg TT\t\tContext Switches\n");
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+		fprintf(outFile, "%-12s\t%-12.2f\t%-12.2f\t%lld\n", algorithm_name(i), totalWaitTimes[i] / MAX(numOfProcesses, 1), totalTurnaroundTimes[i] / MAX(numOfProcesses, 1), totalContextSwitches[i]);
+
+	fprintf(outFile, "\nPer File\n");
+	fprintf(outFile, "File\tProcesses\tAlgorithm\tAvg WT\tAvg TT\tContext Switches\n");
+
+	for(int f = 0; f < batch->numOfFiles; f++)
+	{
+		BatchFile *file = &batch->files[f];
+
+		if(file->failed)
+		{
+			fprintf(outFile, "%s\tUnreadable\n", file->inputName);
+			continue;
+		}
+
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+			fprintf(outFile, "%s\t%d\t%s\t%.2f\t%.2f\t%d\n", file->inputName, file->numOfProcesses, algorithm_name(i), file->avgWaitTimes[i], file->avgTurnaroundTimes[i], file->contextSwitches[i]);
+	}
+
+	free(totalWaitTimes);
+	free(totalTurnaroundTimes);
+	free(totalContextSwitches);
+}
+
+int run_batch(const char *inputs, const char *outDirectory, int interval, int numOfThreads, bool verbose)
+{
+	Batch batch;
+	char **names, **outputs, *summaryName;
+	FILE *summaryFile;
+	struct timespec start;
+	int numOfFailed = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	if((batch.numOfFiles = list_inputs(inputs, &names)) < 0)
+	{
+		free(names);
+		return -1;
+	}
+
+	if(mkdir(outDirectory, 0777) != 0 && errno != EEXIST)
+	{
+		for(int f = 0; f < batch.numOfFiles; f++)
+			free(names[f]);
+		free(names);
+		return -1;
+	}
+
+	outputs = name_outputs(names, batch.numOfFiles);
+	batch.interval = interval;
+	batch.files = (BatchFile *) malloc(sizeof(BatchFile) * MAX(batch.numOfFiles, 1));
+
+	for(int f = 0; f < batch.numOfFiles; f++)
+	{
+		BatchFile *file = &batch.files[f];
+
+		file->inputName = names[f];
+		file->outputName = join_path(outDirectory, outputs[f]);
+		file->processes = NULL;
+		file->numOfProcesses = 0;
+		file->loaded = false;
+		file->failed = false;
+		file->jobsLeft = NUM_OF_ALGORITHMS;
+		file->summaries = (Info **) calloc(NUM_OF_ALGORITHMS, sizeof(Info *));
+		file->outputs = (char **) calloc(NUM_OF_ALGORITHMS, sizeof(char *));
+		file->outputSizes = (size_t *) calloc(NUM_OF_ALGORITHMS, sizeof(size_t));
+		file->avgWaitTimes = (double *) calloc(NUM_OF_ALGORITHMS, sizeof(double));
+		file->avgTurnaroundTimes = (double *) calloc(NUM_OF_ALGORITHMS, sizeof(double));
+		file->contextSwitches = (int *) calloc(NUM_OF_ALGORITHMS, sizeof(int));
+		pthread_mutex_init(&file->lock, NULL);
+
+		free(outputs[f]);
+	}
+
+	free(outputs);
+
+	run_parallel(batch.numOfFiles * NUM_OF_ALGORITHMS, numOfThreads, run_batch_job, &batch);	// Every file and algorithm pair is its own job
+
+	summaryName = join_path(outDirectory, "summary.txt");
+
+	if((summaryFile = fopen(summaryName, "w")) != NULL)
+	{
+		print_batch_summary(summaryFile, &batch);
+		fclose(summaryFile);
+	}
+
+	for(int f = 0; f < batch.numOfFiles; f++)
+	{
+		BatchFile *file = &batch.files[f];
+
+		numOfFailed += file->failed;
+
+		pthread_mutex_destroy(&file->lock);
+		free(file->inputName);
+		free(file->outputName);
+		free(file->avgWaitTimes);
+		free(file->avgTurnaroundTimes);
+		free(file->contextSwitches);
+	}
+
+	if(verbose)																// Report the throughput of the batch
+		fprintf(stderr, "Simulated %d files in %.3f s on %d threads, %.1f files/s\n", batch.numOfFiles, elapsed_seconds(&start), numOfThreads,
+				batch.numOfFiles / MAX(elapsed_seconds(&start), 1e-9));
+
+	free(summaryName);
+	free(batch.files);
+	free(names);
+
+	return numOfFailed;
+}
@@ -0,0 +1,358 @@
+/*************************************************************************************
+File Name: sched_bench.c
+
+Objective: Measure how fast the CPU scheduling simulator parses, simulates and prints
+		   across a matrix of workload sizes and shapes, writing the results in a
+		   machine-readable form that can be compared against an earlier run
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+#include <sys/resource.h>
+
+#define OUTPUT_TICKS 1000					// About how many ticks the output phase prints the trace for, whatever the workload size
+#define MIN_COMPARED_SECONDS 0.01			// Shorter timings are mostly noise, so they are not compared
+#define MAX_SIZES 16
+#define NUM_OF_PHASES 7						// Simulation alone, the generic loop, the run with its output, then the four sampled traces
+#define NUM_OF_SHAPES (int) (sizeof(SHAPES) / sizeof(SHAPES[0]))
+#define RESULTS_PER_WORKLOAD (1 + NUM_OF_PHASES * NUM_OF_ALGORITHMS)	// Parsing, then every phase of every algorithm
+
+typedef struct workloadshape {				// Workload shape structure type - a named workload spec, without its size
+
+	const char *name;
+	const char *spec;
+
+} WorkloadShape;
+
+typedef struct benchresult {				// Bench result structure type - one line of the results
+
+	int size;
+	char shape[16];
+	char phase[24];
+	char algorithm[16];
+	double seconds;							// Best of the repeats
+	double ticksPerSecond;
+	double processesPerSecond;
+	double megabytesPerSecond;
+	long long allocations;
+	long long nodeRequests;
+	long peakRSS;							// Peak resident set size of the whole run so far, in KB
+
+} BenchResult;
+
+static const WorkloadShape SHAPES[] = {
+	{ "uniform", "seed=1" },												// Bursts of 1-100, CPU about busy
+	{ "heavy", "seed=2,burst=pareto:50.5:1" },								// Heavy tailed bursts
+	{ "bursty", "seed=3,arrival=bursty:50.5" },								// Processes arrive in bursts
+	{ "light", "seed=4,arrival=exp:101" }									// CPU about half idle
+};
+
+static const char *TRACE_SAMPLINGS[] = { "every=1", "every=100", "changes", "window=0:1000" };	// Binary traces, from everything down to a small part of the run
+
+static const char *HEADER = "size,shape,phase,algorithm,seconds,ticks_per_sec,procs_per_sec,mb_per_sec,allocations,node_requests,peak_rss_kb";
+
+static long peak_rss()
+{
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+
+	return usage.ru_maxrss;													// KB on Linux
+}
+
+static void add_result(BenchResult *results, int *numOfResults, int capacity, int size, const char *shape, const char *phase, const char *algorithm, double seconds)
+{
+	BenchResult *result;
+
+	if(*numOfResults >= capacity)											// Never written past the end; main makes room for a whole workload first
+		return;
+
+	result = &results[(*numOfResults)++];
+	memset(result, 0, sizeof(BenchResult));
+	result->size = size;
+	snprintf(result->shape, sizeof(result->shape), "%s", shape);
+	snprintf(result->phase, sizeof(result->phase), "%s", phase);
+	snprintf(result->algorithm, sizeof(result->algorithm), "%s", algorithm);
+	result->seconds = seconds;
+	result->processesPerSecond = size / MAX(seconds, 1e-9);
+	result->peakRSS = peak_rss();
+}
+
+static void print_result(FILE *outFile, BenchResult *result)
+{
+	fprintf(outFile, "%d,%s,%s,%s,%.6f,%.0f,%.0f,%.1f,%lld,%lld,%ld\n", result->size, result->shape, result->phase, result->algorithm, result->seconds,
+			result->ticksPerSecond, result->processesPerSecond, result->megabytesPerSecond, result->allocations, result->nodeRequests, result->peakRSS);
+}
+
+static Process* time_parse(const WorkloadSpec *spec, int repeats, int *numOfProcesses, double *seconds, long long *bytes)
+{
+	char fileName[] = "/tmp/sched_bench_XXXXXX";
+	int fd = mkstemp(fileName);
+	FILE *workFile = fdopen(fd, "w");
+	Process *processes = NULL;
+
+	write_workload(workFile, spec);											// Parsed from a real file, the way Project3 reads its input
+	fclose(workFile);
+
+	*seconds = -1;
+
+	for(int r = 0; r < repeats; r++)										// Keep the best of several runs to reduce noise
+	{
+		ParseStats stats;
+
+		free(processes);
+		processes = load_processes(fileName, numOfProcesses, &stats);
+
+		*bytes = stats.bytes;
+		if(*seconds < 0 || stats.seconds < *seconds)
+			*seconds = stats.seconds;
+	}
+
+	unlink(fileName);
+
+	return processes;
+}
+
+static Info* time_simulation(FILE *nullFile, Process *processes, int numOfProcesses, Algorithm algo, bool specialized, bool output, const char *sampling, int repeats, double *seconds, long long *bytes)
+{
+	Info *summary = NULL;
+
+	*seconds = -1;
+
+	for(int r = 0; r < repeats; r++)										// Keep the best of several runs to reduce noise
+	{
+		struct timespec start;
+		Tracer *tracer = NULL;
+		double elapsed;
+
+		if(summary != NULL)
+			destroy_info(summary);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		if(output || sampling != NULL)										// Output phase: the whole run as Project3 prints it, trace included
+		{
+			if(sampling != NULL)											// Trace phases: the run with only a sampled binary trace
+			{
+				TraceSampling traceSampling;
+
+				init_trace_sampling(&traceSampling);
+				parse_trace_sampling(sampling, &traceSampling);
+				tracer = make_binary_tracer(nullFile, algo);
+				sample_tracer(tracer, &traceSampling);
+			}
+			else
+				tracer = make_tracer(nullFile, MAX(numOfProcesses / (OUTPUT_TICKS / 50), 1), false);	// Workloads last about 50 ticks per process
+
+			summary = simulate(nullFile, tracer, processes, numOfProcesses, algo);
+			*bytes = tracer->bytesWritten + tracer->textLength;				// Whatever is still buffered is written when the tracer is destroyed
+			destroy_tracer(tracer);
+		}
+		else
+			summary = specialized ? simulate(nullFile, NULL, processes, numOfProcesses, algo) : simulate_generic(nullFile, NULL, processes, numOfProcesses, algo);
+
+		elapsed = elapsed_seconds(&start);
+
+		if(*seconds < 0 || elapsed < *seconds)
+			*seconds = elapsed;
+	}
+
+	return summary;
+}
+
+static int read_results(const char *fileName, BenchResult *results, int capacity)
+{
+	FILE *inFile = fopen(fileName, "r");
+	char line[512];
+	int count = 0;
+
+	if(inFile == NULL)
+		return -1;
+
+	while(fgets(line, sizeof(line), inFile) != NULL && count < capacity)	// Same format print_result writes; the header does not parse
+	{
+		BenchResult *result = &results[count];
+
+		if(sscanf(line, "%d,%15[^,],%23[^,],%15[^,],%lf,%lf,%lf,%lf,%lld,%lld,%ld", &result->size, result->shape, result->phase, result->algorithm, &result->seconds,
+				  &result->ticksPerSecond, &result->processesPerSecond, &result->megabytesPerSecond, &result->allocations, &result->nodeRequests, &result->peakRSS) == 11)
+			count++;
+	}
+
+	fclose(inFile);
+
+	return count;
+}
+
+static int compare_results(BenchResult *results, int numOfResults, BenchResult *baseline, int numOfBaseline, double tolerance)
+{
+	int regressions = 0;
+
+	for(int i = 0; i < numOfResults; i++)
+	{
+		for(int j = 0; j < numOfBaseline; j++)								// Lines are matched on everything that names them
+		{
+			BenchResult *now = &results[i], *then = &baseline[j];
+
+			if(now->size != then->size || strcmp(now->shape, then->shape) != 0 || strcmp(now->phase, then->phase) != 0 || strcmp(now->algorithm, then->algorithm) != 0)
+				continue;
+
+			if(then->seconds >= MIN_COMPARED_SECONDS && now->seconds > then->seconds * (1 + tolerance))	// Slower beyond the noise allowed for
+			{
+				fprintf(stderr, "REGRESSION %d %s %s %s: %.6f s, was %.6f s (%+.1f%%)\n", now->size, now->shape, now->phase, now->algorithm,
+						now->seconds, then->seconds, 100 * (now->seconds / then->seconds - 1));
+				regressions++;
+			}
+
+			if(now->allocations > then->allocations)						// Allocation counts do not depend on timing, so any increase counts
+			{
+				fprintf(stderr, "REGRESSION %d %s %s %s: %lld allocations, was %lld\n", now->size, now->shape, now->phase, now->algorithm, now->allocations, then->allocations);
+				regressions++;
+			}
+		}
+	}
+
+	return regressions;
+}
+
+int main(int argc, char* argv[])
+{
+	int sizes[MAX_SIZES] = { 10000, 100000 };
+	int numOfSizes = 2, repeats = 3, option, numOfResults = 0, maxResults, numOfBaseline = 0, maxBaseline = MAX_SIZES * NUM_OF_SHAPES * RESULTS_PER_WORKLOAD, numOfSkipped = 0, regressions = 0;
+	bool generic = false, traces = false;
+	double tolerance = 0.10;
+	char *resultsFileName = NULL, *baselineFileName = NULL;
+	FILE *nullFile = fopen("/dev/null", "w"), *resultsFile = stdout;
+	BenchResult *results;
+	BenchResult *baseline = (BenchResult *) malloc(sizeof(BenchResult) * maxBaseline);	// As many lines as any run of this bench writes
+
+	while((option = getopt(argc, argv, "c:Gn:o:r:Tt:")) != -1)
+	{
+		switch(option)
+		{
+			case 'c':
+				baselineFileName = optarg;										// Earlier results to compare against
+				break;
+
+			case 'G':
+				generic = true;													// Also time the single generic simulation loop
+				break;
+
+			case 'n':															// Comma separated workload sizes
+				numOfSizes = 0;
+				for(char *size = strtok(optarg, ","); size != NULL && numOfSizes < MAX_SIZES; size = strtok(NULL, ","))
+					sizes[numOfSizes++] = atoi(size);
+				break;
+
+			case 'o':
+				resultsFileName = optarg;
+				break;
+
+			case 'r':
+				repeats = MAX(atoi(optarg), 1);
+				break;
+
+			case 'T':
+				traces = true;													// Also time runs writing sampled binary traces
+				break;
+
+			case 't':
+				tolerance = atof(optarg) / 100;									// Given in percent
+				break;
+
+			default:
+				printf("Usage: %s [-GT] [-n sizes] [-r repeats] [-o results file] [-c baseline file] [-t tolerance %%]\n", argv[0]);
+				return 0;
+		}
+	}
+
+	maxResults = numOfSizes * NUM_OF_SHAPES * RESULTS_PER_WORKLOAD;				// Room for every phase of every workload, whichever phases are timed
+	results = (BenchResult *) malloc(sizeof(BenchResult) * maxResults);
+
+	if(baselineFileName != NULL && (numOfBaseline = read_results(baselineFileName, baseline, maxBaseline)) < 0)
+	{
+		printf("ERROR: Unable to read baseline file %s.\n", baselineFileName);
+		return 2;
+	}
+
+	if(resultsFileName != NULL && (resultsFile = fopen(resultsFileName, "w")) == NULL)
+	{
+		printf("ERROR: Unable to write results file %s.\n", resultsFileName);
+		return 2;
+	}
+
+	fprintf(resultsFile, "%s\n", HEADER);
+
+	for(int s = 0; s < numOfSizes; s++)
+	{
+		for(int w = 0; w < NUM_OF_SHAPES; w++)
+		{
+			WorkloadSpec spec;
+			Process *processes;
+			int numOfProcesses, first = numOfResults;
+			double seconds;
+			long long bytes = 0;
+
+			if(numOfResults + RESULTS_PER_WORKLOAD > maxResults)			// No room for every result of this workload; it is reported rather than timed
+			{
+				fprintf(stderr, "Results full, skipping size %d %s\n", sizes[s], SHAPES[w].name);
+				numOfSkipped++;
+				continue;
+			}
+
+			init_workload_spec(&spec, sizes[s], 1);							// Same seeds every run, so runs are comparable
+			parse_workload_spec(SHAPES[w].spec, &spec);
+
+			processes = time_parse(&spec, repeats, &numOfProcesses, &seconds, &bytes);
+			add_result(results, &numOfResults, maxResults, sizes[s], SHAPES[w].name, "parse", "-", seconds);
+			results[numOfResults - 1].megabytesPerSecond = bytes / 1e6 / MAX(seconds, 1e-9);
+
+			for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+			{
+				for(int phase = 0; phase < NUM_OF_PHASES; phase++)				// Simulation alone, the generic loop, the run with its output, then the sampled traces
+				{
+					const char *names[] = { "simulate", "simulate_generic", "output", "trace_all", "trace_every100", "trace_changes", "trace_window" };
+					Info *summary;
+
+					if((phase == 1 && !generic) || (phase > 2 && !traces))
+						continue;
+
+					summary = time_simulation(nullFile, processes, numOfProcesses, i, phase != 1, phase == 2, phase > 2 ? TRACE_SAMPLINGS[phase - 3] : NULL, repeats, &seconds, &bytes);
+					add_result(results, &numOfResults, maxResults, sizes[s], SHAPES[w].name, names[phase], algorithm_name(i), seconds);
+
+					results[numOfResults - 1].ticksPerSecond = summary->endTime / MAX(seconds, 1e-9);
+					results[numOfResults - 1].allocations = summary->allocations;
+					results[numOfResults - 1].nodeRequests = summary->nodeRequests;
+					if(phase >= 2)
+						results[numOfResults - 1].megabytesPerSecond = bytes / 1e6 / MAX(seconds, 1e-9);
+
+					destroy_info(summary);
+				}
+			}
+
+			for(int i = first; i < numOfResults; i++)						// Results are written as each workload finishes
+				print_result(resultsFile, &results[i]);
+			fflush(resultsFile);
+
+			free(processes);
+		}
+	}
+
+	if(numOfSkipped > 0)
+		fprintf(stderr, "%d workloads skipped; time fewer sizes at once\n", numOfSkipped);
+
+	if(baselineFileName != NULL)
+	{
+		regressions = compare_results(results, numOfResults, baseline, numOfBaseline, tolerance);
+		fprintf(stderr, "%d regressions against %s (tolerance %.0f%%)\n", regressions, baselineFileName, tolerance * 100);
+	}
+
+	if(resultsFile != stdout)
+		fclose(resultsFile);
+	fclose(nullFile);
+	free(results);
+	free(baseline);
+
+	return regressions > 0 ? 1 : 0;											// Non-zero exit status lets a build be gated on the comparison
+}
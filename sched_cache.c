@@ -0,0 +1,184 @@
+/*************************************************************************************
+File Name: sched_cache.c
+
+Objective: Provide an on-disk cache of simulation results, keyed by a hash of the
+		   processes and the settings they were simulated with, so repeated runs of
+		   the same input skip the simulation
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static unsigned long long hash_bytes(unsigned long long hash, const void *data, size_t length)
+{
+	const unsigned char *bytes = (const unsigned char *) data;
+
+	for(size_t i = 0; i < length; i++)										// FNV-1a: xor in each byte, then multiply
+	{
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+unsigned long long hash_workload(const Process *processes, int numOfProcesses)
+{
+	unsigned long long hash = hash_bytes(FNV_OFFSET, &numOfProcesses, sizeof(int));
+
+	for(int i = 0; i < numOfProcesses; i++)									// Only the fields read from the input; the same file always hashes the same
+	{
+		int fields[4] = { processes[i].ID, processes[i].burstTime, processes[i].priority, processes[i].arrivalTime };
+
+		hash = hash_bytes(hash, fields, sizeof(fields));
+	}
+
+	return hash;
+}
+
+unsigned long long cache_key(unsigned long long workloadHash, Algorithm algo, const SimConfig *config)
+{
+	int settings[5] = { CACHE_FORMAT_VERSION, algo, config->quantum, config->agingPeriod, config->numOfCpus };
+
+	return hash_bytes(workloadHash, settings, sizeof(settings));			// Anything that changes the results changes the key
+}
+
+static void cache_file_name(char *fileName, size_t size, const char *cacheDir, unsigned long long key)
+{
+	snprintf(fileName, size, "%s/%016llx.info", cacheDir, key);
+}
+
+Info* load_cached_info(const char *cacheDir, unsigned long long key, int numOfProcesses)
+{
+	char fileName[PATH_MAX];
+	CacheHeader header;
+	Info *summary;
+	FILE *cacheFile;
+	bool valid;
+
+	cache_file_name(fileName, sizeof(fileName), cacheDir, key);
+
+	if((cacheFile = fopen(fileName, "rb")) == NULL)							// Not cached yet
+		return NULL;
+
+	if(fread(&header, sizeof(header), 1, cacheFile) != 1 || header.version != CACHE_FORMAT_VERSION || header.key != key ||
+	   header.numOfProcesses != numOfProcesses || header.sequenceLength < 0)
+	{
+		fclose(cacheFile);
+		return NULL;
+	}
+
+	summary = make_info(numOfProcesses);
+	summary->avgWaitTime = header.avgWaitTime;
+	summary->avgTurnaroundTime = header.avgTurnaroundTime;
+	summary->contextSwitches = header.contextSwitches;
+	summary->migrations = header.migrations;
+	summary->numOfCpus = header.numOfCpus;
+	summary->endTime = header.endTime;
+	summary->nodeRequests = header.nodeRequests;
+	summary->allocations = header.allocations;
+	summary->vruntimeSpreadMax = header.vruntimeSpreadMax;
+	summary->vruntimeSpreadSum = header.vruntimeSpreadSum;
+	summary->vruntimeSamples = header.vruntimeSamples;
+
+	while(summary->processSequence->capacity < header.sequenceLength)		// Sized once, rather than grown an interval at a time
+		summary->processSequence->capacity *= 2;
+	summary->processSequence->intervals = (Interval *) realloc(summary->processSequence->intervals, sizeof(Interval) * summary->processSequence->capacity);
+	summary->processSequence->length = header.sequenceLength;
+
+	valid = fread(summary->waitTimes, sizeof(int), numOfProcesses, cacheFile) == (size_t) numOfProcesses &&
+			fread(summary->turnaroundTimes, sizeof(int), numOfProcesses, cacheFile) == (size_t) numOfProcesses &&
+			fread(&summary->latency, sizeof(LatencyStats), 1, cacheFile) == 1 &&
+			fread(summary->processSequence->intervals, sizeof(Interval), header.sequenceLength, cacheFile) == (size_t) header.sequenceLength;
+
+	fclose(cacheFile);
+
+	if(!valid)																// A truncated file counts as not cached; it is replaced once simulated again
+	{
+		destroy_info(summary);
+		return NULL;
+	}
+
+	return summary;
+}
+
+bool store_cached_info(const char *cacheDir, unsigned long long key, const Info *summary)
+{
+	char fileName[PATH_MAX], tempName[PATH_MAX + 8];
+	CacheHeader header;
+	FILE *cacheFile;
+	bool written;
+	int fd;
+
+	if(mkdir(cacheDir, 0777) != 0 && errno != EEXIST)
+		return false;
+
+	cache_file_name(fileName, sizeof(fileName), cacheDir, key);
+	snprintf(tempName, sizeof(tempName), "%s.XXXXXX", fileName);
+
+	if((fd = mkstemp(tempName)) < 0)
+		return false;
+
+	if((cacheFile = fdopen(fd, "wb")) == NULL)
+	{
+		close(fd);
+		unlink(tempName);
+		return false;
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.version = CACHE_FORMAT_VERSION;
+	header.key = key;
+	header.numOfProcesses = summary->numOfProcesses;
+	header.sequenceLength = summary->processSequence->length;
+	header.avgWaitTime = summary->avgWaitTime;
+	header.avgTurnaroundTime = summary->avgTurnaroundTime;
+	header.contextSwitches = summary->contextSwitches;
+	header.migrations = summary->migrations;
+	header.numOfCpus = summary->numOfCpus;
+	header.endTime = summary->endTime;
+	header.nodeRequests = summary->nodeRequests;
+	header.allocations = summary->allocations;
+	header.vruntimeSpreadMax = summary->vruntimeSpreadMax;
+	header.vruntimeSpreadSum = summary->vruntimeSpreadSum;
+	header.vruntimeSamples = summary->vruntimeSamples;
+
+	written = fwrite(&header, sizeof(header), 1, cacheFile) == 1 &&
+			  fwrite(summary->waitTimes, sizeof(int), summary->numOfProcesses, cacheFile) == (size_t) summary->numOfProcesses &&
+			  fwrite(summary->turnaroundTimes, sizeof(int), summary->numOfProcesses, cacheFile) == (size_t) summary->numOfProcesses &&
+			  fwrite(&summary->latency, sizeof(LatencyStats), 1, cacheFile) == 1 &&
+			  fwrite(summary->processSequence->intervals, sizeof(Interval), header.sequenceLength, cacheFile) == (size_t) header.sequenceLength;
+
+	written = fclose(cacheFile) == 0 && written;
+
+	if(!written || rename(tempName, fileName) != 0)							// Written under a temporary name, so readers never see a partial file
+	{
+		unlink(tempName);
+		return false;
+	}
+
+	return true;
+}
+
+Info* simulate_cached(FILE *outFile, const char *cacheDir, unsigned long long workloadHash, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config, bool *hit)
+{
+	unsigned long long key = cache_key(workloadHash, algo, config);
+	Info *summary = load_cached_info(cacheDir, key, numOfProcesses);
+
+	*hit = summary != NULL;
+
+	if(*hit)
+		print_title(outFile, algo);											// Printed just as the simulation would have
+	else
+	{
+		summary = simulate_config(outFile, NULL, processes, numOfProcesses, algo, config);
+		store_cached_info(cacheDir, key, summary);							// A cache that cannot be written only costs the next run the simulation
+	}
+
+	return summary;
+}
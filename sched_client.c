@@ -0,0 +1,179 @@
+/*************************************************************************************
+File Name: sched_client.c
+
+Objective: Send a simulation request to a running server (Project3 -S) and print the
+		   results, optionally repeating it from many connections at once to time the
+		   server
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+typedef struct client {					// Client structure type - one connection sending the same request over and over
+
+	const char *socketPath;
+	const char *request;				// Request line and processes, exactly as sent
+	size_t requestLength;
+	int repeats;
+	bool print;							// Whether the answers are printed; only one client prints
+	bool failed;
+	pthread_t thread;
+
+} Client;
+
+static int connect_to_server(const char *socketPath)
+{
+	struct sockaddr_un address;
+	int fd;
+
+	if(strlen(socketPath) >= sizeof(address.sun_path) || (fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		return -1;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+
+	if(connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0)
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+static void* run_client(void *arg)
+{
+	Client *client = (Client *) arg;
+	int fd = connect_to_server(client->socketPath);
+	char *line = NULL;
+	size_t capacity = 0;
+	int answered = 0;
+	FILE *inFile;
+
+	client->failed = true;
+
+	if(fd < 0 || (inFile = fdopen(fd, "r")) == NULL)
+		return NULL;
+
+	for(int i = 0; i < client->repeats; i++, answered++)
+	{
+		bool done = false;
+
+		if(write(fd, client->request, client->requestLength) != (ssize_t) client->requestLength)
+			break;
+
+		while(!done && getline(&line, &capacity, inFile) != -1)				// Every answer ends with DONE, or ERROR if the server gave up on the connection
+		{
+			done = strcmp(line, "DONE\n") == 0 || strncmp(line, "ERROR", 5) == 0;
+
+			if(client->print && i == 0)
+				fputs(line, stdout);
+		}
+
+		if(!done || strncmp(line, "ERROR", 5) == 0)
+			break;
+	}
+
+	client->failed = answered < client->repeats;
+
+	free(line);
+	fclose(inFile);
+
+	return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+	int option, repeats = 1, numOfClients = 1, numOfFailed = 0;
+	char *request = NULL;
+	size_t requestLength;
+	struct timespec start;
+	Client *clients;
+	FILE *requestFile;
+
+	while((option = getopt(argc, argv, "c:r:")) != -1)
+	{
+		switch(option)
+		{
+			case 'c':
+				numOfClients = MAX(atoi(optarg), 1);									// Connections sending the request at the same time
+				break;
+
+			case 'r':
+				repeats = MAX(atoi(optarg), 1);											// Times each connection sends the request
+				break;
+
+			default:
+				printf("Usage: %s [-c <clients>] [-r <repeats>] <socket path> <settings> [<input file>]\n", argv[0]);
+				return 0;
+		}
+	}
+
+	if(argc - optind < 2)																// Simple detection if not enough command line arguments were sent
+	{
+		printf("Usage: %s [-c <clients>] [-r <repeats>] <socket path> <settings> [<input file>]\n", argv[0]);
+		printf("Ex. %s -c 4 -r 100 sched.sock \"algo=rr quantum=8\" testin1.dat\n", argv[0]);
+		printf("Ex. %s sched.sock \"cpus=2 workload=n=10000,seed=7\"\n", argv[0]);
+		return 0;
+	}
+
+	signal(SIGPIPE, SIG_IGN);															// A server that goes away only fails the connections to it
+
+	requestFile = open_memstream(&request, &requestLength);								// Built once, then sent as is every time
+
+	if(argc - optind > 2)																// Processes are read here and sent after the request line
+	{
+		ParseStats parseStats;
+		int numOfProcesses;
+		Process *processes = load_processes(argv[optind + 2], &numOfProcesses, &parseStats);
+
+		if(processes == NULL)
+		{
+			printf("ERROR: Unable to read input file %s.\n", argv[optind + 2]);
+			return 0;
+		}
+
+		fprintf(requestFile, "SIMULATE %s processes=%d\n", argv[optind + 1], numOfProcesses);
+		for(int i = 0; i < numOfProcesses; i++)
+			fprintf(requestFile, "%d %d %d\n", processes[i].burstTime, processes[i].priority, processes[i].arrivalTime);
+
+		free(processes);
+	}
+	else
+		fprintf(requestFile, "SIMULATE %s\n", argv[optind + 1]);
+
+	fclose(requestFile);
+
+	clients = (Client *) malloc(sizeof(Client) * numOfClients);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for(int i = 0; i < numOfClients; i++)
+	{
+		clients[i].socketPath = argv[optind];
+		clients[i].request = request;
+		clients[i].requestLength = requestLength;
+		clients[i].repeats = repeats;
+		clients[i].print = i == 0;
+		pthread_create(&clients[i].thread, NULL, run_client, &clients[i]);
+	}
+
+	for(int i = 0; i < numOfClients; i++)
+	{
+		pthread_join(clients[i].thread, NULL);
+		numOfFailed += clients[i].failed;
+	}
+
+	if(numOfFailed > 0)
+		printf("ERROR: %d of %d connections to %s failed.\n", numOfFailed, numOfClients, argv[optind]);
+
+	if(repeats > 1 || numOfClients > 1)													// Report the rate only when there is more than one request to time
+		fprintf(stderr, "%d requests in %.3f s, %.1f requests/s\n", numOfClients * repeats, elapsed_seconds(&start), numOfClients * repeats / MAX(elapsed_seconds(&start), 1e-9));
+
+	free(clients);
+	free(request);
+
+	return 0;
+}
@@ -0,0 +1,51 @@
+/*************************************************************************************
+File Name: sched_gen.c
+
+Objective: Write a seeded synthetic workload in the input file format of the CPU
+		   scheduling simulator
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+int main(int argc, char* argv[])
+{
+	WorkloadSpec spec;
+	FILE *outFile;
+	long long bytes;
+
+	if(argc < 3)																// Simple detection if not enough command line arguments were sent
+	{
+		printf("Usage: %s <workload spec> <output file>\n", argv[0]);
+		printf("Ex. %s n=1000000,seed=7,burst=pareto:20:1,priority=uniform:0:9,arrival=bursty:20 work.dat\n", argv[0]);
+		return 0;
+	}
+
+	init_workload_spec(&spec, 1000, 1);											// Anything the spec leaves out keeps its default
+
+	if(!parse_workload_spec(argv[1], &spec))
+	{
+		printf("ERROR: Invalid workload spec %s.\n", argv[1]);
+		return 0;
+	}
+
+	outFile = strcmp(argv[2], "-") == 0 ? stdout : fopen(argv[2], "w");		// "-" writes the workload to standard output
+
+	if(outFile == NULL)
+	{
+		printf("ERROR: Unable to write output file %s.\n", argv[2]);
+		return 0;
+	}
+
+	bytes = write_workload(outFile, &spec);
+
+	if(outFile != stdout)
+	{
+		fclose(outFile);
+		printf("Wrote %d processes (%lld bytes) to %s\n", spec.numOfProcesses, bytes, argv[2]);
+	}
+
+	return 0;
+}
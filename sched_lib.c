@@ -0,0 +1,107 @@
+/*************************************************************************************
+File Name: sched_lib.c
+
+Objective: Provide the CPU scheduling simulator as a library, so other programs can run
+		   simulations in process, from any number of threads, without files
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+struct simcontext {							// Everything a run keeps between runs; one context per thread
+
+	Info *summary;							// Last run's results, which the per-process times handed out point into
+	Tracer *tracer;							// Reused by every run that traces
+
+};
+
+SimContext* make_sim_context()
+{
+	SimContext *context = (SimContext *) malloc(sizeof(SimContext));
+
+	context->summary = NULL;
+	context->tracer = NULL;
+
+	return context;
+}
+
+void init_sim_options(SimOptions *options, Algorithm algo)
+{
+	SimConfig config;
+
+	init_sim_config(&config);												// Same defaults as Project3
+
+	options->algo = algo;
+	options->quantum = config.quantum;
+	options->agingPeriod = config.agingPeriod;
+	options->numOfCpus = config.numOfCpus;
+	options->trace = NULL;
+	options->traceContext = NULL;
+}
+
+static void summarize_histogram(LatencySummary *summary, const Histogram *histogram)
+{
+	summary->mean = histogram->sum / MAX(histogram->count, 1);
+	summary->p50 = histogram_percentile(histogram, 50);
+	summary->p90 = histogram_percentile(histogram, 90);
+	summary->p99 = histogram_percentile(histogram, 99);
+	summary->max = histogram->max;
+}
+
+int run_sim_context(SimContext *context, const Process *processes, int numOfProcesses, const SimOptions *options, SimResults *results)
+{
+	SimConfig config;
+	Tracer *tracer = NULL;
+
+	if(processes == NULL || numOfProcesses < 1 || options->algo < FCFS || options->algo > CFS ||	// Rejected rather than simulated, since nothing is printed to explain
+	   options->quantum < 1 || options->agingPeriod < 1 || options->numOfCpus < 1)
+		return -1;
+
+	init_sim_config(&config);
+	config.quantum = options->quantum;
+	config.agingPeriod = options->agingPeriod;
+	config.numOfCpus = options->numOfCpus;
+
+	if(options->trace != NULL)												// The tracer is kept for the next run; only its callback changes
+	{
+		if(context->tracer == NULL)
+			context->tracer = make_callback_tracer(options->trace, options->traceContext);
+
+		context->tracer->callback = options->trace;
+		context->tracer->callbackContext = options->traceContext;
+		tracer = context->tracer;
+	}
+
+	if(context->summary != NULL)											// Results of the last run are no longer needed
+		destroy_info(context->summary);
+
+	context->summary = simulate_config(NULL, tracer, processes, numOfProcesses, options->algo, &config);	// Nothing is printed; everything is in the results
+
+	results->avgWaitTime = context->summary->avgWaitTime;
+	results->avgTurnaroundTime = context->summary->avgTurnaroundTime;
+	results->contextSwitches = context->summary->contextSwitches;
+	results->migrations = context->summary->migrations;
+	results->endTime = context->summary->endTime;
+	results->numOfProcesses = numOfProcesses;
+	summarize_histogram(&results->wait, &context->summary->latency.wait);
+	summarize_histogram(&results->turnaround, &context->summary->latency.turnaround);
+	summarize_histogram(&results->response, &context->summary->latency.response);
+	results->waitTimes = context->summary->waitTimes;
+	results->turnaroundTimes = context->summary->turnaroundTimes;
+
+	return 0;
+}
+
+void destroy_sim_context(SimContext *context)
+{
+	if(context->summary != NULL)
+		destroy_info(context->summary);
+
+	if(context->tracer != NULL)
+		destroy_tracer(context->tracer);
+
+	free(context);															// Destroy/deallocate the memory reserved for the context
+	context = NULL;
+}
@@ -0,0 +1,120 @@
+/*************************************************************************************
+File Name: sched_pool.c
+
+Objective: Provide the work-stealing thread pool that runs many independent simulations
+		   at once
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+int default_thread_count()
+{
+	long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return count > 0 ? (int) count : 1;
+}
+
+static int take_job(WorkRange *range)
+{
+	int job = -1;
+
+	pthread_mutex_lock(&range->lock);
+	if(range->first < range->last)											// Owner works from the front of its range
+		job = range->first++;
+	pthread_mutex_unlock(&range->lock);
+
+	return job;
+}
+
+static bool steal_jobs(ThreadPool *pool, int thief)
+{
+	for(int i = 1; i < pool->numOfThreads; i++)								// Look at every other thread, starting with the next one
+	{
+		WorkRange *victim = &pool->ranges[(thief + i) % pool->numOfThreads];
+		int first = 0, last = 0;
+
+		pthread_mutex_lock(&victim->lock);
+		if(victim->first < victim->last)									// Take the back half (rounded up) of what the victim has left
+		{
+			first = victim->last - (victim->last - victim->first + 1) / 2;
+			last = victim->last;
+			victim->last = first;
+		}
+		pthread_mutex_unlock(&victim->lock);
+
+		if(first < last)
+		{
+			pthread_mutex_lock(&pool->ranges[thief].lock);
+			pool->ranges[thief].first = first;
+			pool->ranges[thief].last = last;
+			pthread_mutex_unlock(&pool->ranges[thief].lock);
+			return true;
+		}
+	}
+
+	return false;															// Jobs never add jobs, so nothing left anywhere means the thread is done
+}
+
+static void* run_pool_thread(void *arg)
+{
+	PoolThread *self = (PoolThread *) arg;
+	ThreadPool *pool = self->pool;
+	int job;
+
+	while(true)
+	{
+		if((job = take_job(&pool->ranges[self->index])) != -1)
+			pool->run(pool->context, job);
+		else if(!steal_jobs(pool, self->index))
+			break;
+	}
+
+	return NULL;
+}
+
+void run_parallel(int numOfJobs, int numOfThreads, JobFunction run, void *context)
+{
+	ThreadPool pool;
+	PoolThread *threads;
+
+	numOfThreads = MAX(MIN(numOfThreads, numOfJobs), 1);					// No more threads than jobs
+
+	if(numOfThreads == 1)													// Nothing to gain from a thread
+	{
+		for(int i = 0; i < numOfJobs; i++)
+			run(context, i);
+		return;
+	}
+
+	pool.run = run;
+	pool.context = context;
+	pool.numOfThreads = numOfThreads;
+	pool.ranges = (WorkRange *) malloc(sizeof(WorkRange) * numOfThreads);
+	threads = (PoolThread *) malloc(sizeof(PoolThread) * numOfThreads);
+
+	for(int i = 0; i < numOfThreads; i++)									// Contiguous shares, so neighbouring jobs tend to run on the same thread
+	{
+		pool.ranges[i].first = (int) ((long long) numOfJobs * i / numOfThreads);
+		pool.ranges[i].last = (int) ((long long) numOfJobs * (i + 1) / numOfThreads);
+		pthread_mutex_init(&pool.ranges[i].lock, NULL);
+	}
+
+	for(int i = 0; i < numOfThreads; i++)
+	{
+		threads[i].pool = &pool;
+		threads[i].index = i;
+		pthread_create(&threads[i].thread, NULL, run_pool_thread, &threads[i]);
+	}
+
+	for(int i = 0; i < numOfThreads; i++)
+		pthread_join(threads[i].thread, NULL);
+
+	for(int i = 0; i < numOfThreads; i++)
+		pthread_mutex_destroy(&pool.ranges[i].lock);
+
+	free(pool.ranges);
+	free(threads);
+}
@@ -0,0 +1,405 @@
+/*************************************************************************************
+File Name: sched_server.c
+
+Objective: Provide server mode, which keeps worker threads running and answers
+		   simulation requests sent over a Unix domain socket (or standard input),
+		   so small simulations do not each pay for starting a program and files
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+static const char *algorithmKeys[] = { "fcfs", "sjf", "stcf", "rr", "npp", "cfs" };	// How requests and results name each algorithm
+
+static volatile sig_atomic_t serverInterrupted = 0;
+static int serverWakeFd = -1;												// Write end of the running server's wake pipe, for the interrupt handler
+
+static void wake_server(int fd)
+{
+	ssize_t written = write(fd, "", 1);										// A full pipe already holds a wakeup, so a failed write needs nothing more
+
+	(void) written;
+}
+
+static void interrupt_server(int signum)
+{
+	int savedErrno = errno;
+
+	serverInterrupted = 1;
+	wake_server(serverWakeFd);												// Wakes the accepting thread's poll wherever the signal lands, even just before it
+	errno = savedErrno;
+}
+
+static const char* parse_request(char *line, ServerRequest *request)
+{
+	char *save, *setting = strtok_r(line, " \t\r\n", &save);
+
+	if(strcmp(setting, "SIMULATE") != 0)
+		return "unknown request";
+
+	init_sim_options(&request->options, FCFS);
+	request->allAlgorithms = true;
+	request->numOfProcesses = 0;
+	request->generated = false;
+
+	while((setting = strtok_r(NULL, " \t\r\n", &save)) != NULL)				// Settings are name=value, separated by spaces
+	{
+		char *value = strchr(setting, '=');
+		bool valid = true;
+
+		if(value == NULL)
+			return "invalid setting";
+
+		*value++ = '\0';
+
+		if(strcmp(setting, "algo") == 0)
+		{
+			request->allAlgorithms = strcmp(value, "all") == 0;
+			valid = request->allAlgorithms;
+
+			for(int i = 0; i < NUM_OF_ALGORITHMS && !valid; i++)
+			{
+				if(strcmp(value, algorithmKeys[i]) == 0)
+				{
+					request->options.algo = i;
+					valid = true;
+				}
+			}
+		}
+		else if(strcmp(setting, "quantum") == 0)
+			valid = (request->options.quantum = atoi(value)) > 0;
+		else if(strcmp(setting, "aging") == 0)
+			valid = (request->options.agingPeriod = atoi(value)) > 0;
+		else if(strcmp(setting, "cpus") == 0)
+			valid = (request->options.numOfCpus = atoi(value)) > 0;
+		else if(strcmp(setting, "processes") == 0)
+			valid = (request->numOfProcesses = atoi(value)) > 0;
+		else if(strcmp(setting, "workload") == 0)
+		{
+			init_workload_spec(&request->workload, 1000, 1);				// Anything the spec leaves out keeps its default, as with -w
+			valid = request->generated = parse_workload_spec(value, &request->workload);
+		}
+		else
+			valid = false;
+
+		if(!valid)
+			return "invalid setting";
+	}
+
+	if(request->generated == (request->numOfProcesses > 0))					// The processes either follow the request or are generated, never both
+		return "give either processes= or workload=";
+
+	return NULL;
+}
+
+static const char* read_request_processes(FILE *inFile, const ServerRequest *request, ParseState *state)
+{
+	char *line = NULL;
+	size_t capacity = 0;
+	ssize_t length;
+
+	while(state->numOfProcesses < request->numOfProcesses && (length = getline(&line, &capacity, inFile)) != -1)	// In the input file format, any number to a line
+		parse_processes(state, line, length);
+
+	free(line);
+
+	if(state->inNumber)															// Input ended in the middle of the last number
+		parse_processes(state, "\n", 1);
+
+	if(state->numOfProcesses != request->numOfProcesses || state->field != 0)
+		return state->numOfProcesses < request->numOfProcesses ? "too few processes" : "too many processes";
+
+	return NULL;
+}
+
+static void print_request_results(FILE *outFile, Algorithm algo, const SimResults *results)
+{
+	fprintf(outFile, "RESULT algo=%s processes=%d wait=%.2f turnaround=%.2f switches=%d migrations=%d end=%d", algorithmKeys[algo], results->numOfProcesses,
+			results->avgWaitTime, results->avgTurnaroundTime, results->contextSwitches, results->migrations, results->endTime);
+	fprintf(outFile, " wait_p50=%d wait_p99=%d wait_max=%d turnaround_p99=%d response_p50=%d response_p99=%d\n", results->wait.p50, results->wait.p99,
+			results->wait.max, results->turnaround.p99, results->response.p50, results->response.p99);
+}
+
+static bool answer_request(FILE *inFile, FILE *outFile, SimContext *context, ServerRequest *request)
+{
+	ParseState state = { NULL, 0, 0, 0, 0, false, false, 0, 0 };
+	const char *error = NULL;
+	Process *processes;
+	int numOfProcesses;
+
+	if(request->generated)
+		processes = generate_processes(&request->workload, &numOfProcesses);
+	else
+	{
+		error = read_request_processes(inFile, request, &state);
+		processes = state.processes;
+		numOfProcesses = state.numOfProcesses;
+	}
+
+	if(error != NULL)															// The rest of the input cannot be told apart from the processes, so the connection ends here
+	{
+		fprintf(outFile, "ERROR %s\n", error);
+		free(processes);
+		return false;
+	}
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+	{
+		SimResults results;
+
+		if(!request->allAlgorithms && i != request->options.algo)
+			continue;
+
+		request->options.algo = i;
+		if(run_sim_context(context, processes, numOfProcesses, &request->options, &results) == 0)
+			print_request_results(outFile, i, &results);
+		else
+			fprintf(outFile, "ERROR algo=%s cannot be simulated\n", algorithmKeys[i]);
+	}
+
+	fprintf(outFile, "DONE\n");
+	free(processes);
+
+	return true;
+}
+
+int serve_connection(FILE *inFile, FILE *outFile, SimContext *context)
+{
+	char *line = NULL;
+	size_t capacity = 0;
+	int requests = 0;
+	bool open = true;
+
+	while(open && getline(&line, &capacity, inFile) != -1)						// One request at a time; the next is not read until this one is answered
+	{
+		ServerRequest request;
+		const char *error;
+
+		if(line[strspn(line, " \t\r\n")] == '\0')								// Blank lines between requests are ignored
+			continue;
+
+		if((error = parse_request(line, &request)) != NULL)
+		{
+			fprintf(outFile, "ERROR %s\n", error);
+			open = false;
+		}
+		else if((open = answer_request(inFile, outFile, context, &request)))
+			requests++;
+
+		fflush(outFile);														// Every answer is sent as soon as it is complete
+	}
+
+	free(line);
+
+	return requests;
+}
+
+static void* run_server_worker(void *arg)
+{
+	ServerWorker *self = (ServerWorker *) arg;
+	Server *server = self->server;
+	SimContext *context = make_sim_context();									// Kept for every connection the worker serves
+
+	while(true)
+	{
+		FILE *inFile, *outFile;
+		struct timespec start;
+		int fd, requests = 0;
+
+		pthread_mutex_lock(&server->lock);
+		while(server->numOfPending == 0 && !server->stopping)
+			pthread_cond_wait(&server->notEmpty, &server->lock);
+
+		if(server->numOfPending == 0)											// Stopping, with no connections left
+		{
+			pthread_mutex_unlock(&server->lock);
+			break;
+		}
+
+		fd = server->pending[server->firstPending];
+		server->firstPending = (server->firstPending + 1) % SERVER_BACKLOG;
+		if(server->numOfPending-- == SERVER_BACKLOG)							// The accepting thread stops accepting while the ring is full
+			wake_server(server->wakeFds[1]);
+		server->active[self->index] = fd;
+		pthread_mutex_unlock(&server->lock);
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		inFile = fdopen(fd, "r");
+		outFile = fdopen(dup(fd), "w");											// Separate streams, so reading and writing do not share a buffer
+
+		if(inFile != NULL && outFile != NULL)
+			requests = serve_connection(inFile, outFile, context);
+
+		pthread_mutex_lock(&server->lock);
+		server->active[self->index] = -1;										// Before the connection is closed, so the number is never shut down once reused
+		server->requests += requests;
+		pthread_mutex_unlock(&server->lock);
+
+		if(outFile != NULL)
+			fclose(outFile);
+
+		if(inFile != NULL)
+			fclose(inFile);
+		else
+			close(fd);
+
+		if(server->verbose)
+			fprintf(stderr, "Worker %d: %d requests in %.3f s\n", self->index, requests, elapsed_seconds(&start));
+	}
+
+	destroy_sim_context(context);
+
+	return NULL;
+}
+
+static void stop_server(Server *server)
+{
+	pthread_mutex_lock(&server->lock);
+	server->stopping = true;
+
+	for(int i = 0; i < server->numOfThreads; i++)								// Connections being served end as if the client had closed them
+	{
+		if(server->active[i] != -1)
+			shutdown(server->active[i], SHUT_RDWR);
+	}
+
+	for(; server->numOfPending > 0; server->numOfPending--)						// Connections still waiting are never served
+	{
+		close(server->pending[server->firstPending]);
+		server->firstPending = (server->firstPending + 1) % SERVER_BACKLOG;
+	}
+
+	pthread_cond_broadcast(&server->notEmpty);
+	pthread_mutex_unlock(&server->lock);
+}
+
+int run_server(const char *socketPath, int numOfThreads, bool verbose)
+{
+	Server server;
+	ServerWorker *workers;
+	struct sockaddr_un address;
+	struct sigaction action;
+	struct stat info;
+	sigset_t signals, oldSignals;
+
+	if(strlen(socketPath) >= sizeof(address.sun_path))
+		return -1;
+
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, socketPath);
+
+	if(stat(socketPath, &info) == 0 && S_ISSOCK(info.st_mode))					// Left behind by a server that did not stop cleanly; anything else is left alone
+		unlink(socketPath);
+
+	if(pipe(server.wakeFds) != 0)
+		return -1;
+
+	if((server.listenFd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || bind(server.listenFd, (struct sockaddr *) &address, sizeof(address)) != 0 ||
+	   listen(server.listenFd, SERVER_BACKLOG) != 0)
+	{
+		if(server.listenFd >= 0)
+			close(server.listenFd);
+		close(server.wakeFds[0]);
+		close(server.wakeFds[1]);
+		return -1;
+	}
+
+	fcntl(server.wakeFds[0], F_SETFL, O_NONBLOCK);							// Drained without blocking, and never blocks a writer
+	fcntl(server.wakeFds[1], F_SETFL, O_NONBLOCK);
+	fcntl(server.listenFd, F_SETFL, O_NONBLOCK);							// A client gone between poll and accept must not block the accept
+	serverWakeFd = server.wakeFds[1];
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = interrupt_server;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+	signal(SIGPIPE, SIG_IGN);													// A client that goes away mid-answer only ends its own connection
+
+	server.numOfThreads = numOfThreads;
+	server.firstPending = 0;
+	server.numOfPending = 0;
+	server.active = (int *) malloc(sizeof(int) * numOfThreads);
+	server.stopping = false;
+	server.verbose = verbose;
+	server.requests = 0;
+	pthread_mutex_init(&server.lock, NULL);
+	pthread_cond_init(&server.notEmpty, NULL);
+
+	sigemptyset(&signals);														// Workers never take the interrupt, so it always reaches the accepting thread
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, &oldSignals);
+
+	workers = (ServerWorker *) malloc(sizeof(ServerWorker) * numOfThreads);
+	for(int i = 0; i < numOfThreads; i++)
+	{
+		server.active[i] = -1;
+		workers[i].server = &server;
+		workers[i].index = i;
+		pthread_create(&workers[i].thread, NULL, run_server_worker, &workers[i]);
+	}
+
+	pthread_sigmask(SIG_SETMASK, &oldSignals, NULL);
+
+	if(verbose)
+		fprintf(stderr, "Serving %s on %d threads\n", socketPath, numOfThreads);
+
+	while(!serverInterrupted)
+	{
+		struct pollfd waits[2] = { { server.wakeFds[0], POLLIN, 0 }, { server.listenFd, POLLIN, 0 } };
+		char wakeups[64];
+		int fd;
+
+		pthread_mutex_lock(&server.lock);
+		if(server.numOfPending == SERVER_BACKLOG)								// Every worker is busy and the ring is full; wait only for room or an interrupt, the listen backlog holds the rest
+			waits[1].events = 0;
+		pthread_mutex_unlock(&server.lock);
+
+		if(poll(waits, 2, -1) < 0 && errno != EINTR)
+			break;
+
+		while(read(server.wakeFds[0], wakeups, sizeof(wakeups)) > 0)			// Every wakeup is handled by looking again, so they are all drained at once
+			;
+
+		if((waits[1].revents & POLLIN) == 0)
+			continue;
+
+		if((fd = accept(server.listenFd, NULL, NULL)) < 0)
+		{
+			if(errno == EINTR || errno == ECONNABORTED || errno == EAGAIN || errno == EWOULDBLOCK)
+				continue;
+			break;
+		}
+
+		pthread_mutex_lock(&server.lock);
+		server.pending[(server.firstPending + server.numOfPending) % SERVER_BACKLOG] = fd;
+		server.numOfPending++;
+		pthread_cond_signal(&server.notEmpty);
+		pthread_mutex_unlock(&server.lock);
+	}
+
+	close(server.listenFd);
+	unlink(socketPath);
+	stop_server(&server);
+
+	for(int i = 0; i < numOfThreads; i++)
+		pthread_join(workers[i].thread, NULL);
+
+	if(verbose)
+		fprintf(stderr, "Served %lld requests\n", server.requests);
+
+	pthread_mutex_destroy(&server.lock);
+	pthread_cond_destroy(&server.notEmpty);
+	serverWakeFd = -1;														// Before the pipe is closed, so a late interrupt never writes to a reused descriptor
+	close(server.wakeFds[0]);
+	close(server.wakeFds[1]);
+	free(workers);
+	free(server.active);
+
+	return 0;
+}
@@ -15,23 +15,494 @@ File History:
 
 #include "sched_sim.h"
 
+const int QUANTUM = 2;													// Defaults live with the simulator, so programs using it as a library need not define them
+
+const int NUM_OF_ALGORITHMS = 6;
+
+const QueueType SORTED_QUEUE_TYPE = HEAP_QUEUE;
+
+static const int cfsWeights[40] = { 88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,	// Weights of priorities -20 through 19, as the
+									9548, 7620, 6100, 4904, 3906, 3121, 2501, 1991, 1586, 1277,				// Linux scheduler gives nice values
+									1024, 820, 655, 526, 423, 335, 272, 215, 172, 137,
+									110, 87, 70, 56, 45, 36, 29, 23, 18, 15 };
+
+void init_node_pool(NodePool *pool, size_t nodeSize)
+{
+	pool->nodeSize = MAX(nodeSize, sizeof(void *));		// Nodes must be able to hold the free list link
+	pool->freeNodes = NULL;
+	pool->chunks = NULL;
+	pool->unused = NULL;
+	pool->unusedNodes = 0;
+	pool->chunkNodes = 64;								// Start small so short simulations do not reserve much memory
+	pool->requests = 0;
+	pool->allocations = 0;
+}
+
+void* pool_alloc(NodePool *pool)
+{
+	void *node;
+
+	pool->requests++;
+
+	if(pool->freeNodes != NULL)							// Reuse a returned node if there is one
+	{
+		node = pool->freeNodes;
+		pool->freeNodes = *(void **) node;
+		return node;
+	}
+
+	if(pool->unusedNodes == 0)							// Otherwise carve from the newest chunk, allocating a new chunk when it is used up
+	{
+		void *chunk = malloc(sizeof(void *) + pool->nodeSize * pool->chunkNodes);	// Chunk link is stored in front of the nodes
+
+		*(void **) chunk = pool->chunks;
+		pool->chunks = chunk;
+		pool->unused = (char *) chunk + sizeof(void *);
+		pool->unusedNodes = pool->chunkNodes;
+		pool->allocations++;
+
+		if(pool->chunkNodes < 65536)					// Grow the chunks geometrically so large simulations need few of them
+			pool->chunkNodes *= 2;
+	}
+
+	node = pool->unused;
+	pool->unused += pool->nodeSize;
+	pool->unusedNodes--;
+
+	return node;
+}
+
+void pool_free(NodePool *pool, void *node)
+{
+	*(void **) node = pool->freeNodes;					// Push the node onto the free list
+	pool->freeNodes = node;
+}
+
+void release_node_pool(NodePool *pool)
+{
+	void *next;
+
+	while(pool->chunks != NULL)							// Destroy/deallocate every chunk, which frees every node at once
+	{
+		next = *(void **) pool->chunks;
+		free(pool->chunks);
+		pool->chunks = next;
+	}
+
+	pool->freeNodes = NULL;
+	pool->unused = NULL;
+	pool->unusedNodes = 0;
+}
+
 Queue* make_queue()
 {
 	Queue *queue = (Queue *) malloc(sizeof(Queue));
 
 	queue->head = NULL;									// An empty queue will have both head and tail pointing to NULL
 	queue->tail = NULL;
+	init_node_pool(&queue->nodePool, sizeof(Node));
+
+	queue->type = LIST_QUEUE;
+	queue->front.ID = -1;
+	queue->heap = NULL;
+	queue->heapSize = 0;
+	queue->heapCapacity = 0;
+	queue->nextOrder = 0;
+	queue->printBuffer = NULL;
+	queue->printCapacity = 0;
+	queue->heapAllocations = 0;
+	queue->root = NULL;
+	queue->leftmost = NULL;
+	queue->minVruntime = 0;
+	queue->totalWeight = 0;
+	queue->length = 0;
+	INSTRUMENT(queue->sortedEnqueues = 0; queue->enqueueSteps = 0; queue->longestEnqueue = 0; queue->maxLength = 0;)
+
+	return queue;
+}
+
+Queue* make_heap_queue()
+{
+	Queue *queue = make_queue();						// Piggyback initialize function for list queue
+
+	queue->type = HEAP_QUEUE;
+	queue->heapCapacity = 16;
+	queue->heap = (HeapEntry *) malloc(sizeof(HeapEntry) * queue->heapCapacity);
+	queue->heapAllocations++;
+
+	return queue;
+}
+
+Queue* make_tree_queue()
+{
+	Queue *queue = make_queue();						// Piggyback initialize function for list queue
+
+	queue->type = TREE_QUEUE;
+	init_node_pool(&queue->nodePool, sizeof(TreeNode));	// Tree nodes come from the same pool, sized for them instead
 
 	return queue;
 }
 
-void enqueue_process(Queue *queue, Process *process)
+static bool heap_entry_before(HeapEntry *a, HeapEntry *b)
+{
+	return a->key < b->key || (a->key == b->key && a->order > b->order);	// Lower key first; among equal keys the later insertion first
+}
+
+static void heap_push(Queue *queue, int ID, int key)
+{
+	int i = queue->heapSize++;							// Start at the new bottom of the heap and sift up
+	HeapEntry entry = { ID, key, queue->nextOrder++ };
+	INSTRUMENT(int steps = 0;)
+
+	if(queue->heapSize > queue->heapCapacity)			// Grow the heap array when it is full
+	{
+		queue->heapCapacity *= 2;
+		queue->heap = (HeapEntry *) realloc(queue->heap, sizeof(HeapEntry) * queue->heapCapacity);
+		queue->heapAllocations++;
+	}
+
+	while(i > 0 && heap_entry_before(&entry, &queue->heap[(i - 1) / 2]))
+	{
+		queue->heap[i] = queue->heap[(i - 1) / 2];		// Move parent down until the new entry's spot is found
+		i = (i - 1) / 2;
+		INSTRUMENT(steps++;)
+	}
+
+	queue->heap[i] = entry;
+	INSTRUMENT(queue->enqueueSteps += steps; queue->longestEnqueue = MAX(queue->longestEnqueue, steps);)
+}
+
+static HeapEntry heap_pop(Queue *queue)
+{
+	HeapEntry top = queue->heap[0];						// Smallest entry; its spot is refilled by sifting the last entry down
+	HeapEntry last = queue->heap[--queue->heapSize];
+	int i = 0, child;
+
+	while((child = 2 * i + 1) < queue->heapSize)
+	{
+		if(child + 1 < queue->heapSize && heap_entry_before(&queue->heap[child + 1], &queue->heap[child]))
+			child++;									// Follow the smaller child
+
+		if(!heap_entry_before(&queue->heap[child], &last))
+			break;
+
+		queue->heap[i] = queue->heap[child];
+		i = child;
+	}
+
+	if(queue->heapSize > 0)
+		queue->heap[i] = last;
+
+	return top;
+}
+
+static void heap_enqueue_process(Queue *queue, int ID, int key)
+{
+	if(queue->front.ID == -1)							// If queue is empty, the new process will be the only process
+	{
+		queue->front.ID = ID;
+		queue->front.key = key;
+	}
+	else if(queue->front.key > key)						// If the head's key is greater, the new process becomes the head and the old
+	{													// head goes back as the most recent insertion, ahead of any equal keys
+		heap_push(queue, queue->front.ID, queue->front.key);
+		queue->front.ID = ID;
+		queue->front.key = key;
+	}
+	else												// In every other instance the new process goes behind the head, ahead of
+		heap_push(queue, ID, key);						// processes with an equal key - the same spot the sorted lists give it
+}
+
+static int compare_heap_entries(const void *a, const void *b)
+{
+	return heap_entry_before((HeapEntry *) a, (HeapEntry *) b) ? -1 : 1;	// Entries are never equal since every insertion number is unique
+}
+
+static int subtree_size(TreeNode *node)
+{
+	return node == NULL ? 0 : node->size;
+}
+
+static void rotate_left(Queue *queue, TreeNode *node)
+{
+	TreeNode *child = node->right;						// The right child takes the node's place and the node becomes its left child
+
+	node->right = child->left;
+	if(child->left != NULL)
+		child->left->parent = node;
+
+	child->parent = node->parent;
+	if(node->parent == NULL)
+		queue->root = child;
+	else if(node == node->parent->left)
+		node->parent->left = child;
+	else
+		node->parent->right = child;
+
+	child->left = node;
+	node->parent = child;
+
+	child->size = node->size;							// The subtree holds the same nodes; only the node's own count changes
+	node->size = subtree_size(node->left) + subtree_size(node->right) + 1;
+}
+
+static void rotate_right(Queue *queue, TreeNode *node)
+{
+	TreeNode *child = node->left;						// Mirror image of rotate_left
+
+	node->left = child->right;
+	if(child->right != NULL)
+		child->right->parent = node;
+
+	child->parent = node->parent;
+	if(node->parent == NULL)
+		queue->root = child;
+	else if(node == node->parent->right)
+		node->parent->right = child;
+	else
+		node->parent->left = child;
+
+	child->right = node;
+	node->parent = child;
+
+	child->size = node->size;
+	node->size = subtree_size(node->left) + subtree_size(node->right) + 1;
+}
+
+static bool is_red(TreeNode *node)
+{
+	return node != NULL && node->red;					// Missing children count as black
+}
+
+static int tree_insert(Queue *queue, int ID, long long key, long long order)
+{
+	TreeNode *node = (TreeNode *) pool_alloc(&queue->nodePool);
+	TreeNode *parent = NULL, **link = &queue->root;
+	int position = 0;
+	INSTRUMENT(int steps = 0;)
+
+	node->ID = ID;
+	node->red = true;
+	node->key = key;
+	node->order = order;
+	node->size = 1;
+	node->left = NULL;
+	node->right = NULL;
+
+	while(*link != NULL)								// Walk down to the new node's spot, counting the nodes passed on the left
+	{
+		parent = *link;
+		parent->size++;
+
+		if(key < parent->key || (key == parent->key && order < parent->order))
+			link = &parent->left;
+		else
+		{
+			position += subtree_size(parent->left) + 1;
+			link = &parent->right;
+		}
+		INSTRUMENT(steps++;)
+	}
+
+	INSTRUMENT(queue->enqueueSteps += steps; queue->longestEnqueue = MAX(queue->longestEnqueue, steps);)
+
+	node->parent = parent;
+	*link = node;
+
+	if(position == 0)									// Nothing comes before the new node, so it is the new head
+		queue->leftmost = node;
+
+	while(is_red(node->parent))							// Fix any red node with a red parent, recoloring up the tree and rotating at most twice
+	{
+		TreeNode *grandparent = node->parent->parent;	// A red parent is never the root, so there is always a grandparent
+
+		if(node->parent == grandparent->left)
+		{
+			if(is_red(grandparent->right))
+			{
+				node->parent->red = false;
+				grandparent->right->red = false;
+				grandparent->red = true;
+				node = grandparent;
+			}
+			else
+			{
+				if(node == node->parent->right)
+				{
+					node = node->parent;
+					rotate_left(queue, node);
+				}
+
+				node->parent->red = false;
+				grandparent->red = true;
+				rotate_right(queue, grandparent);
+			}
+		}
+		else
+		{
+			if(is_red(grandparent->left))
+			{
+				node->parent->red = false;
+				grandparent->left->red = false;
+				grandparent->red = true;
+				node = grandparent;
+			}
+			else
+			{
+				if(node == node->parent->left)
+				{
+					node = node->parent;
+					rotate_right(queue, node);
+				}
+
+				node->parent->red = false;
+				grandparent->red = true;
+				rotate_left(queue, grandparent);
+			}
+		}
+	}
+
+	queue->root->red = false;
+
+	return position;
+}
+
+static void tree_remove_leftmost(Queue *queue)
+{
+	TreeNode *node = queue->leftmost, *child = node->right, *parent = node->parent;
+
+	for(TreeNode *ancestor = parent; ancestor != NULL; ancestor = ancestor->parent)
+		ancestor->size--;
+
+	if(child != NULL)									// The leftmost node has no left child, so its right child takes its place
+		child->parent = parent;
+
+	if(parent == NULL)
+		queue->root = child;
+	else
+		parent->left = child;
+
+	if(child != NULL)									// The next head is the leftmost node of that child, or else the parent
+	{
+		queue->leftmost = child;
+		while(queue->leftmost->left != NULL)
+			queue->leftmost = queue->leftmost->left;
+	}
+	else
+		queue->leftmost = parent;
+
+	if(!node->red)										// Removing a black node leaves its side one black short; fix it up the tree
+	{
+		while(child != queue->root && !is_red(child))
+		{
+			TreeNode *sibling;
+
+			if(child == parent->left)
+			{
+				sibling = parent->right;				// Never missing, since the other side has the extra black
+
+				if(sibling->red)
+				{
+					sibling->red = false;
+					parent->red = true;
+					rotate_left(queue, parent);
+					sibling = parent->right;
+				}
+
+				if(!is_red(sibling->left) && !is_red(sibling->right))
+				{
+					sibling->red = true;
+					child = parent;
+					parent = child->parent;
+				}
+				else
+				{
+					if(!is_red(sibling->right))
+					{
+						sibling->left->red = false;
+						sibling->red = true;
+						rotate_right(queue, sibling);
+						sibling = parent->right;
+					}
+
+					sibling->red = parent->red;
+					parent->red = false;
+					sibling->right->red = false;
+					rotate_left(queue, parent);
+					child = queue->root;
+				}
+			}
+			else
+			{
+				sibling = parent->left;
+
+				if(sibling->red)
+				{
+					sibling->red = false;
+					parent->red = true;
+					rotate_right(queue, parent);
+					sibling = parent->left;
+				}
+
+				if(!is_red(sibling->left) && !is_red(sibling->right))
+				{
+					sibling->red = true;
+					child = parent;
+					parent = child->parent;
+				}
+				else
+				{
+					if(!is_red(sibling->left))
+					{
+						sibling->right->red = false;
+						sibling->red = true;
+						rotate_left(queue, sibling);
+						sibling = parent->left;
+					}
+
+					sibling->red = parent->red;
+					parent->red = false;
+					sibling->left->red = false;
+					rotate_right(queue, parent);
+					child = queue->root;
+				}
+			}
+		}
+
+		if(child != NULL)
+			child->red = false;
+	}
+
+	pool_free(&queue->nodePool, node);
+}
+
+static TreeNode* tree_next(TreeNode *node)
+{
+	if(node->right != NULL)								// The next node is the leftmost of the right subtree, or else the first
+	{													// ancestor reached from its left
+		node = node->right;
+		while(node->left != NULL)
+			node = node->left;
+		return node;
+	}
+
+	while(node->parent != NULL && node == node->parent->right)
+		node = node->parent;
+
+	return node->parent;
+}
+
+void enqueue_process(Queue *queue, int ID)
 {
-	Node *newNode = (Node *) malloc(sizeof(Node));		// Allocate new memory to store the new node in the queue
+	Node *newNode = (Node *) pool_alloc(&queue->nodePool);	// Take a node from the queue's pool to store the new node in the queue
 
-	newNode->data = process;							// New node will contain pointer to process and point to NULL
+	newNode->ID = ID;									// New node will contain the process ID and point to NULL
+	newNode->key = 0;
 	newNode->next = NULL;								// as it will be the new tail
 
+	queue->length++;
+	INSTRUMENT(queue->maxLength = MAX(queue->maxLength, queue->length);)
+
 	if(is_queue_empty(queue))							// If queue is empty, the new node will be the only node
 	{
 		queue->head = newNode;
@@ -44,13 +515,26 @@ void enqueue_process(Queue *queue, Process *process)
 	}
 }
 
-void burst_time_enqueue_process(Queue *queue, Process *process)
+void sorted_enqueue_process(Queue *queue, int ID, int key)
 {
 	Node *current;										// Temporary tracking node to progress through queue
-	Node *newNode = (Node *) malloc(sizeof(Node));		// Allocate new memory to store the new node in the queue
+	Node *newNode;
+	INSTRUMENT(int steps = 0;)
+
+	queue->length++;
+	INSTRUMENT(queue->maxLength = MAX(queue->maxLength, queue->length); queue->sortedEnqueues++;)
+
+	if(queue->type == HEAP_QUEUE)						// Heap queues find the spot in O(log N) rather than walking the list
+	{
+		heap_enqueue_process(queue, ID, key);
+		return;
+	}
 
-	newNode->data = process;							// New node will contain pointer to process and point to NULL
-	newNode->next = NULL;								// as it may become the new tail
+	newNode = (Node *) pool_alloc(&queue->nodePool);	// Take a node from the queue's pool to store the new node in the queue
+
+	newNode->ID = ID;									// New node will contain the process ID and its key and point to NULL
+	newNode->key = key;									// as it may become the new tail
+	newNode->next = NULL;
 
 	if(is_queue_empty(queue))							// If queue is empty, the new node will be the only node
 	{
@@ -59,20 +543,23 @@ void burst_time_enqueue_process(Queue *queue, Process *process)
 		return;
 	}
 
-	current = queue->head;						// Start tracking through the queue starting from the head
+	current = queue->head;								// Start tracking through the queue starting from the head
 
-	if(queue->head->data->burstTime > process->burstTime)	// If first node's burst time is greater than new node's
-	{														// the new node becomes the first node/head
+	if(queue->head->key > key)							// If first node's key is greater than new node's
+	{													// the new node becomes the first node/head
 		newNode->next = queue->head;
 		queue->head = newNode;
 	}
 	else
 	{
-		while(current->next != NULL && current->next->data->burstTime < process->burstTime)
+		while(current->next != NULL && current->next->key < key)
 		{
-			current = current->next;					// Progress through the queue until either the end is reached or a longer burst time is found
+			current = current->next;					// Progress through the queue until either the end is reached or a greater key is found
+			INSTRUMENT(steps++;)
 		}
 
+		INSTRUMENT(queue->enqueueSteps += steps; queue->longestEnqueue = MAX(queue->longestEnqueue, steps);)
+
 		if(queue->tail == current)						// If the end is reached, the new node will be the new tail
 			queue->tail = newNode;
 
@@ -81,335 +568,1113 @@ void burst_time_enqueue_process(Queue *queue, Process *process)
 	}
 }
 
-void time_remaining_enqueue_process(Queue *queue, Process *process)
+int tree_enqueue_process(Queue *queue, int ID, long long key)
 {
-	Node *current;										// Temporary tracking node to progress through queue
-	Node *newNode = (Node *) malloc(sizeof(Node));		// Allocate new memory to store the new node in the queue
+	queue->length++;
+	INSTRUMENT(queue->maxLength = MAX(queue->maxLength, queue->length); queue->sortedEnqueues++;)
 
-	newNode->data = process;							// New node will contain pointer to process and point to NULL
-	newNode->next = NULL;								// as it may become the new tail
+	return tree_insert(queue, ID, key, queue->nextOrder++);	// Later insertions go behind equal keys, so equal virtual runtimes take turns
+}
 
-	if(is_queue_empty(queue))							// If queue is empty, the new node will be the only node
+void insert_process(Queue *queue, int ID, int position)
+{
+	Node *newNode = (Node *) pool_alloc(&queue->nodePool);	// Take a node from the queue's pool to store the new node in the queue
+	Node *current = queue->head;
+
+	newNode->ID = ID;
+	newNode->key = 0;
+	queue->length++;
+
+	if(position == 0 || is_queue_empty(queue))			// The new node becomes the head, and the tail too if it is the only node
 	{
+		newNode->next = queue->head;
 		queue->head = newNode;
-		queue->tail = newNode;
+		if(queue->tail == NULL)
+			queue->tail = newNode;
 		return;
 	}
 
-	current = queue->head;							// Start tracking through the queue starting from the head
+	for(int i = 1; i < position && current->next != NULL; i++)	// Progress through the queue to the node the new node goes behind
+		current = current->next;
 
-	if(queue->head->data->timeRemaining > process->timeRemaining)	// If first node's time remaining is greater than new node's
-	{																// the new node becomes the first node/head
-		newNode->next = queue->head;
-		queue->head = newNode;
+	if(queue->tail == current)
+		queue->tail = newNode;
+
+	newNode->next = current->next;
+	current->next = newNode;
+}
+
+int dequeue_process(Queue *queue)
+{
+	int ID;											// Holder variable to store ID of first node
+	Node *temp;										// Holder variable to store the data of the first node
+
+	if(is_queue_empty(queue))						// If queue is currently empty, return -1 to flag such
+		return -1;
+
+	queue->length--;
 
+	if(queue->type == HEAP_QUEUE)					// Heap queues hand out the head and promote the smallest heap entry to replace it
+	{
+		ID = queue->front.ID;
+		queue->front = queue->heapSize > 0 ? heap_pop(queue) : (HeapEntry) { -1, 0, 0 };
+		return ID;
 	}
-	else
+
+	if(queue->type == TREE_QUEUE)					// Tree queues hand out their leftmost node
+	{
+		ID = queue->leftmost->ID;
+		tree_remove_leftmost(queue);
+		return ID;
+	}
+
+	temp = queue->head;								// Set temporary node to point to head
+	ID = temp->ID;									// Store the head's ID since it will soon be unavailable
+
+	queue->head = queue->head->next;				// Forget the previous head by advancing the head pointer up the list
+
+	pool_free(&queue->nodePool, temp);				// Since the temporary node still points to the original head, we return it to the pool for reuse
+
+	if(queue->head == NULL)							// If the queue only had one node, then signal tail pointer to point to NULL as well to avoid a dangling pointer
+		queue->tail = NULL;
+
+	return ID;										// Return the ID of the original first node
+}
+
+int peek_queue(Queue *queue)
+{
+	if(queue->type == HEAP_QUEUE)
+		return queue->front.ID;						// Return the ID of the head of a heap queue
+
+	if(queue->type == TREE_QUEUE)
+		return queue->leftmost->ID;					// Return the ID of the leftmost node of a tree queue
+
+	return queue->head->ID;							// Return the ID of the first node in the queue
+}
+
+int queue_contents(Queue *queue, int *ids)
+{
+	int count = 0;
+
+	if(is_queue_empty(queue))
+		return 0;
+
+	if(queue->type == HEAP_QUEUE)						// Heap queues are read from a sorted copy of the heap, behind the head
+	{
+		if(queue->heapSize > queue->printCapacity)		// Grow the scratch space only when the heap has outgrown it
+		{
+			queue->printCapacity = queue->heapCapacity;
+			queue->printBuffer = (HeapEntry *) realloc(queue->printBuffer, sizeof(HeapEntry) * queue->printCapacity);
+			queue->heapAllocations++;
+		}
+
+		if(queue->heapSize > 0)							// Only the front entry; the scratch space may not exist yet
+		{
+			memcpy(queue->printBuffer, queue->heap, sizeof(HeapEntry) * queue->heapSize);
+			qsort(queue->printBuffer, queue->heapSize, sizeof(HeapEntry), compare_heap_entries);
+		}
+
+		ids[count++] = queue->front.ID;
+		for(int i = 0; i < queue->heapSize; i++)
+			ids[count++] = queue->printBuffer[i].ID;
+
+		return count;
+	}
+
+	if(queue->type == TREE_QUEUE)						// Tree queues are read in order from the leftmost node
+	{
+		for(TreeNode *current = queue->leftmost; current != NULL; current = tree_next(current))
+			ids[count++] = current->ID;
+
+		return count;
+	}
+
+	for(Node *current = queue->head; current != NULL; current = current->next)	// Progress through the queue until the end is reached
+		ids[count++] = current->ID;
+
+	return count;
+}
+
+bool is_queue_empty(Queue *queue)
+{
+	if(queue->type == HEAP_QUEUE)
+		return queue->front.ID == -1;				// A heap queue is empty when it has no head
+
+	if(queue->type == TREE_QUEUE)
+		return queue->root == NULL;					// A tree queue is empty when it has no root
+
+	return queue->head == NULL && queue->tail == NULL;		// If the head and tail point to NULL, then the queue is empty
+}
+
+void print_queue(FILE *outFile, Queue *queue)
+{
+	Node *current;										// Temporary tracking node to progress through queue
+
+	if(is_queue_empty(queue))							// If queue is empty, print as such
+	{
+		fprintf(outFile, "Empty\n");
+		return;
+	}
+
+	if(queue->type == HEAP_QUEUE)						// Heap queues are printed from a sorted copy of the heap, behind the head
+	{
+		HeapEntry *sorted;
+
+		if(queue->heapSize > queue->printCapacity)		// Grow the scratch space only when the heap has outgrown it
+		{
+			queue->printCapacity = queue->heapCapacity;
+			queue->printBuffer = (HeapEntry *) realloc(queue->printBuffer, sizeof(HeapEntry) * queue->printCapacity);
+			queue->heapAllocations++;
+		}
+
+		sorted = queue->printBuffer;
+		if(queue->heapSize > 0)							// Only the front entry; the scratch space may not exist yet
+		{
+			memcpy(sorted, queue->heap, sizeof(HeapEntry) * queue->heapSize);
+			qsort(sorted, queue->heapSize, sizeof(HeapEntry), compare_heap_entries);
+		}
+
+		fprintf(outFile, "%d", queue->front.ID);
+		for(int i = 0; i < queue->heapSize; i++)
+			fprintf(outFile, "-%d", sorted[i].ID);
+		fprintf(outFile, "\n");
+
+		return;
+	}
+
+	if(queue->type == TREE_QUEUE)						// Tree queues are printed in order from the leftmost node
+	{
+		fprintf(outFile, "%d", queue->leftmost->ID);
+		for(TreeNode *next = tree_next(queue->leftmost); next != NULL; next = tree_next(next))
+			fprintf(outFile, "-%d", next->ID);
+		fprintf(outFile, "\n");
+
+		return;
+	}
+
+	for(current = queue->head; current->next != NULL; current = current->next)	// Progress through the queue until the end is reached
+		fprintf(outFile, "%d-", current->ID);			// Print out the ID's of the processes
+
+	fprintf(outFile, "%d\n", queue->tail->ID);			// Print out the tail of the queue; Accounting for a single node queue
+}
+
+Queue* copy_queue(Queue *queue)
+{
+	Queue *copy = queue->type == HEAP_QUEUE ? make_heap_queue() : queue->type == TREE_QUEUE ? make_tree_queue() : make_queue();
+
+	if(queue->type == HEAP_QUEUE)						// Heap arrays are copied as they are, so equal keys keep their insertion order
+	{
+		copy->heapCapacity = queue->heapCapacity;
+		copy->heap = (HeapEntry *) realloc(copy->heap, sizeof(HeapEntry) * copy->heapCapacity);
+		memcpy(copy->heap, queue->heap, sizeof(HeapEntry) * queue->heapSize);
+		copy->heapSize = queue->heapSize;
+		copy->front = queue->front;
+		copy->nextOrder = queue->nextOrder;
+		copy->length = queue->length;
+	}
+	else if(queue->type == TREE_QUEUE)					// Tree nodes are inserted again in order, keeping their insertion numbers
+	{
+		for(TreeNode *current = queue->leftmost; current != NULL; current = tree_next(current))
+			tree_insert(copy, current->ID, current->key, current->order);
+
+		copy->nextOrder = queue->nextOrder;
+		copy->length = queue->length;
+	}
+	else
+	{
+		for(Node *current = queue->head; current != NULL; current = current->next)
+		{
+			enqueue_process(copy, current->ID);			// Sorted lists are already in order; only the keys need copying
+			copy->tail->key = current->key;
+		}
+	}
+
+	copy->nodePool.requests = queue->nodePool.requests;	// Counts carry on from the original, as if the copy had done its work
+	copy->nodePool.allocations = queue->nodePool.allocations;
+	copy->heapAllocations = queue->heapAllocations;
+	copy->minVruntime = queue->minVruntime;
+	copy->totalWeight = queue->totalWeight;
+	INSTRUMENT(copy->sortedEnqueues = queue->sortedEnqueues; copy->enqueueSteps = queue->enqueueSteps; copy->longestEnqueue = queue->longestEnqueue; copy->maxLength = queue->maxLength;)
+
+	return copy;
+}
+
+void destroy_queue(Queue *queue)
+{
+	release_node_pool(&queue->nodePool);				// Destroy/deallocate every node of the queue at once
+
+	free(queue->heap);									// Destroy/deallocate the heap arrays, if any
+	free(queue->printBuffer);
+
+	free(queue);										// Destroy/deallocate the memory reserved for the queue
+	queue = NULL;
+}
+
+Timeline* make_timeline()
+{
+	Timeline *timeline = (Timeline *) malloc(sizeof(Timeline));
+
+	timeline->capacity = 64;								// Grown by doubling, so long runs only reallocate a handful of times
+	timeline->intervals = (Interval *) malloc(sizeof(Interval) * timeline->capacity);
+	timeline->length = 0;
+	timeline->allocations = 1;
+
+	return timeline;
+}
+
+void add_to_timeline(Timeline *timeline, int ID, int startTime)
+{
+	end_timeline(timeline, startTime);						// The process loaded before this one stops when this one starts
+	add_cpu_to_timeline(timeline, ID, 0, startTime);
+}
+
+int add_cpu_to_timeline(Timeline *timeline, int ID, int cpu, int startTime)
+{
+	if(timeline->length == timeline->capacity)
+	{
+		timeline->capacity *= 2;
+		timeline->intervals = (Interval *) realloc(timeline->intervals, sizeof(Interval) * timeline->capacity);
+		timeline->allocations++;
+	}
+
+	timeline->intervals[timeline->length].ID = ID;
+	timeline->intervals[timeline->length].cpu = cpu;
+	timeline->intervals[timeline->length].start = startTime;
+	timeline->intervals[timeline->length].end = -1;			// Still running until it is ended
+
+	return timeline->length++;
+}
+
+void end_timeline(Timeline *timeline, int endTime)
+{
+	if(timeline->length > 0 && timeline->intervals[timeline->length - 1].end == -1)
+		timeline->intervals[timeline->length - 1].end = endTime;
+}
+
+void print_timeline(FILE *outFile, Timeline *timeline)
+{
+	if(timeline->length == 0)								// If timeline is empty, print as such
+	{
+		fprintf(outFile, "Empty\n");
+		return;
+	}
+
+	for(int i = 0; i < timeline->length - 1; i++)
+		fprintf(outFile, "%d-", timeline->intervals[i].ID);	// Print out the ID's of the processes
+
+	fprintf(outFile, "%d\n", timeline->intervals[timeline->length - 1].ID);	// Print out the last process without a dash after it
+}
+
+void print_gantt_chart(FILE *outFile, Timeline *timeline)
+{
+	bool multipleCpus = false;
+
+	for(int i = 0; i < timeline->length; i++)
+		multipleCpus = multipleCpus || timeline->intervals[i].cpu > 0;
+
+	for(int i = 0; i < timeline->length; i++)				// One line per interval, idle gaps show as jumps in time
+	{
+		fprintf(outFile, "%d-%d: Process %d", timeline->intervals[i].start, timeline->intervals[i].end, timeline->intervals[i].ID);
+
+		if(multipleCpus)									// Which CPU only matters when there is more than one
+			fprintf(outFile, " on CPU %d", timeline->intervals[i].cpu);
+
+		fprintf(outFile, "\n");
+	}
+}
+
+Timeline* copy_timeline(Timeline *timeline)
+{
+	Timeline *copy = (Timeline *) malloc(sizeof(Timeline));
+
+	*copy = *timeline;
+	copy->intervals = (Interval *) malloc(sizeof(Interval) * copy->capacity);
+	memcpy(copy->intervals, timeline->intervals, sizeof(Interval) * timeline->length);
+
+	return copy;
+}
+
+void destroy_timeline(Timeline *timeline)
+{
+	free(timeline->intervals);
+
+	free(timeline);											// Destroy/deallocate the memory reserved for the timeline
+	timeline = NULL;										// Set pointer to NULL to avoid dangling pointer
+}
+
+typedef struct arrival {					// Sorting helper pairing a process with its arrival time
+	int arrivalTime;
+	int ID;
+} Arrival;
+
+static int compare_arrivals(const void *a, const void *b)
+{
+	const Arrival *x = (const Arrival *) a, *y = (const Arrival *) b;
+
+	if(x->arrivalTime != y->arrivalTime)					// Earlier arrivals first, then lower IDs - the order the old scan admitted them in
+		return x->arrivalTime < y->arrivalTime ? -1 : 1;
+
+	return x->ID < y->ID ? -1 : (x->ID > y->ID);
+}
+
+static int compare_ids(const void *a, const void *b)
+{
+	return *(const int *) a < *(const int *) b ? -1 : (*(const int *) a > *(const int *) b);
+}
+
+AdmissionIndex* make_admission_index(const Process *processes, int numOfProcesses)
+{
+	AdmissionIndex *index = (AdmissionIndex *) malloc(sizeof(AdmissionIndex));
+	Arrival *arrivals = (Arrival *) malloc(sizeof(Arrival) * (numOfProcesses + 1));
+
+	for(int i = 0; i < numOfProcesses; i++)
+	{
+		arrivals[i].arrivalTime = processes[i].arrivalTime;
+		arrivals[i].ID = i;
+	}
+
+	qsort(arrivals, numOfProcesses, sizeof(Arrival), compare_arrivals);		// Sort once so each tick only looks at the processes actually arriving
+
+	index->arrivalOrder = (int *) malloc(sizeof(int) * (numOfProcesses + 1));
+	for(int i = 0; i < numOfProcesses; i++)
+		index->arrivalOrder[i] = arrivals[i].ID;
+
+	index->cursor = 0;
+	index->numOfProcesses = numOfProcesses;
+	index->numWaiting = 0;
+	index->waitingCapacity = 4;												// At most one process is preempted per tick, so this rarely grows
+	index->waiting = (int *) malloc(sizeof(int) * index->waitingCapacity);
+
+	free(arrivals);
+
+	return index;
+}
+
+void add_waiting_process(AdmissionIndex *index, int ID)
+{
+	int i = index->numWaiting++;
+
+	if(index->numWaiting > index->waitingCapacity)							// Grow the waiting set when it is full
+	{
+		index->waitingCapacity *= 2;
+		index->waiting = (int *) realloc(index->waiting, sizeof(int) * index->waitingCapacity);
+	}
+
+	while(i > 0 && index->waiting[i - 1] > ID)								// Keep the waiting set in ascending ID order
+	{
+		index->waiting[i] = index->waiting[i - 1];
+		i--;
+	}
+
+	index->waiting[i] = ID;
+}
+
+int next_arrival_time(AdmissionIndex *index, const Process *processes)
+{
+	if(index->cursor >= index->numOfProcesses)
+		return INT_MAX;
+
+	return processes[index->arrivalOrder[index->cursor]].arrivalTime;
+}
+
+void begin_admissions(AdmissionIndex *index, const Process *processes, int currentTime)
+{
+	int *arrived = &index->arrivalOrder[index->cursor];
+
+	index->nextArrived = index->cursor;										// The processes arriving now start at the cursor
+	index->nextWaiting = 0;
+
+	while(index->cursor < index->numOfProcesses && processes[index->arrivalOrder[index->cursor]].arrivalTime <= currentTime)
+		index->cursor++;														// Advance past every process that has arrived by now
+
+	if(index->cursor - index->nextArrived > 1 && processes[arrived[0]].arrivalTime != processes[index->arrivalOrder[index->cursor - 1]].arrivalTime)
+		qsort(arrived, index->cursor - index->nextArrived, sizeof(int), compare_ids);	// Only needed if arrivals from earlier times are admitted together
+}
+
+int next_admission(AdmissionIndex *index)
+{
+	int ID;
+
+	if(index->nextArrived < index->cursor && (index->nextWaiting >= index->numWaiting || index->arrivalOrder[index->nextArrived] < index->waiting[index->nextWaiting]))
+		return index->arrivalOrder[index->nextArrived++];					// Merge new arrivals and waiting processes in ID order, as the old scan did
+
+	if(index->nextWaiting < index->numWaiting)
+	{
+		ID = index->waiting[index->nextWaiting++];
+
+		if(index->nextWaiting == index->numWaiting)							// Every waiting process has been handed back
+			index->numWaiting = index->nextWaiting = 0;
+
+		return ID;
+	}
+
+	return -1;																// No more processes enter the ready queue at this time
+}
+
+AdmissionIndex* copy_admission_index(AdmissionIndex *index)
+{
+	AdmissionIndex *copy = (AdmissionIndex *) malloc(sizeof(AdmissionIndex));
+
+	*copy = *index;
+	copy->arrivalOrder = (int *) malloc(sizeof(int) * (index->numOfProcesses + 1));
+	memcpy(copy->arrivalOrder, index->arrivalOrder, sizeof(int) * index->numOfProcesses);
+	copy->waiting = (int *) malloc(sizeof(int) * index->waitingCapacity);
+	memcpy(copy->waiting, index->waiting, sizeof(int) * index->numWaiting);
+
+	return copy;
+}
+
+void destroy_admission_index(AdmissionIndex *index)
+{
+	free(index->arrivalOrder);
+	free(index->waiting);
+
+	free(index);															// Destroy/deallocate the memory reserved for the admission index
+	index = NULL;
+}
+
+Info* make_info(int numOfProcesses)
+{
+	Info* information = (Info *) malloc(sizeof(Info));
+
+	information->avgWaitTime = 0;
+	information->avgTurnaroundTime = 0;
+	information->processSequence = make_timeline();			// Piggyback initialize function for included timeline
+	information->contextSwitches = 0;
+	information->migrations = 0;
+	information->numOfCpus = 1;
+	information->endTime = 0;
+	information->numOfProcesses = numOfProcesses;
+	information->waitTimes = (int *) malloc(sizeof(int) * (numOfProcesses + 1));
+	information->turnaroundTimes = (int *) malloc(sizeof(int) * (numOfProcesses + 1));
+	init_latency_stats(&information->latency);
+	information->nodeRequests = 0;
+	information->allocations = 0;
+	information->vruntimeSpreadMax = 0;
+	information->vruntimeSpreadSum = 0;
+	information->vruntimeSamples = 0;
+	INSTRUMENT(memset(&information->instrumentation, 0, sizeof(Instrumentation));)
+
+	return information;
+}
+
+Info* copy_info(Info *information)
+{
+	Info *copy = (Info *) malloc(sizeof(Info));
+	size_t size = sizeof(int) * (information->numOfProcesses + 1);
+
+	*copy = *information;													// Latency histograms are copied along with the rest
+	copy->processSequence = copy_timeline(information->processSequence);
+	copy->waitTimes = (int *) malloc(size);
+	copy->turnaroundTimes = (int *) malloc(size);
+	memcpy(copy->waitTimes, information->waitTimes, sizeof(int) * information->numOfProcesses);
+	memcpy(copy->turnaroundTimes, information->turnaroundTimes, sizeof(int) * information->numOfProcesses);
+
+	return copy;
+}
+
+void destroy_info(Info *information)
+{
+	destroy_timeline(information->processSequence);			// Piggyback destroy function for included timeline
+
+	free(information->waitTimes);							// Destroy/deallocate the per-process results
+	free(information->turnaroundTimes);
+
+	free(information);										// Destroy/deallocate the memory reserved for the info type
+	information = NULL;										// Set pointer to NULL to avoid dangling pointer
+}
+
+void init_histogram(Histogram *histogram)
+{
+	memset(histogram->counts, 0, sizeof(histogram->counts));
+	histogram->count = 0;
+	histogram->sum = 0;
+	histogram->max = 0;
+}
+
+static int histogram_bucket(int value)
+{
+	int shift = 0;
+
+	while((value >> shift) >= 2 * HISTOGRAM_SUB_BUCKETS)					// Every power of two above the exact range gets HISTOGRAM_SUB_BUCKETS buckets
+		shift++;
+
+	return shift * HISTOGRAM_SUB_BUCKETS + (value >> shift);
+}
+
+void record_value(Histogram *histogram, int value)
+{
+	value = MAX(value, 0);
+
+	histogram->counts[histogram_bucket(value)]++;
+	histogram->count++;
+	histogram->sum += value;
+	histogram->max = MAX(histogram->max, value);
+}
+
+int histogram_percentile(const Histogram *histogram, double percentile)
+{
+	long long rank = (long long) ceil(percentile / 100 * histogram->count), seen = 0;
+
+	for(int i = 0; i < HISTOGRAM_BUCKETS; i++)
+	{
+		seen += histogram->counts[i];
+
+		if(seen >= MAX(rank, 1))											// Highest value that falls in the bucket, but never past the largest value recorded
+		{
+			int shift = i < 2 * HISTOGRAM_SUB_BUCKETS ? 0 : i / HISTOGRAM_SUB_BUCKETS - 1;
+			long long highest = ((long long) (i - shift * HISTOGRAM_SUB_BUCKETS + 1) << shift) - 1;
+
+			return (int) MIN(highest, histogram->max);
+		}
+	}
+
+	return histogram->max;
+}
+
+void init_latency_stats(LatencyStats *stats)
+{
+	init_histogram(&stats->wait);
+	init_histogram(&stats->turnaround);
+	init_histogram(&stats->response);
+}
+
+void record_finished_process(Info *summary, int ID, int turnaroundTime, int burstTime)
+{
+	summary->turnaroundTimes[ID] = turnaroundTime;
+	summary->waitTimes[ID] = turnaroundTime - burstTime;
+
+	summary->avgTurnaroundTime += turnaroundTime;							// Sums until the simulation ends, then averages
+	summary->avgWaitTime += turnaroundTime - burstTime;
+
+	record_value(&summary->latency.turnaround, turnaroundTime);
+	record_value(&summary->latency.wait, turnaroundTime - burstTime);
+}
+
+void print_latency_stats(FILE *outFile, const LatencyStats *stats)
+{
+	const Histogram *histograms[] = { &stats->wait, &stats->turnaround, &stats->response };
+	const char *names[] = { "Wait Time", "Turnaround Time", "Response Time" };
+
+	fprintf(outFile, "%-16s%10s%10s%10s%10s%10s\n", "Latency", "Mean", "p50", "p90", "p99", "Max");
+
+	for(int i = 0; i < 3; i++)
+		fprintf(outFile, "%-16s%10.2f%10d%10d%10d%10d\n", names[i], histograms[i]->sum / MAX(histograms[i]->count, 1), histogram_percentile(histograms[i], 50),
+				histogram_percentile(histograms[i], 90), histogram_percentile(histograms[i], 99), histograms[i]->max);
+}
+
+#ifdef SCHED_INSTRUMENT
+void print_instrumentation(FILE *outFile, const Info *summary, Algorithm algo)
+{
+	const Instrumentation *counters = &summary->instrumentation;
+	const char *phases[] = { "admit", "dispatch", "advance", "trace" };
+	unsigned long long total = 0;
+
+	for(int i = 0; i < NUM_OF_PHASES; i++)
+		total += counters->cycles[i];
+
+	fprintf(outFile, "%s instrumentation: %lld events, %llu cycles (%.1f per event)\n", algorithm_name(algo), counters->events, total, (double) total / MAX(counters->events, 1));
+
+	for(int i = 0; i < NUM_OF_PHASES; i++)
+		fprintf(outFile, "\t%-10s%16llu cycles %5.1f%%\n", phases[i], counters->cycles[i], 100.0 * counters->cycles[i] / MAX(total, 1));
+
+	fprintf(outFile, "\t%-10s%16llu cycles of it printing the ready queue\n", "", counters->queueCycles);
+	fprintf(outFile, "\tsorted enqueues %lld, %.2f steps on average, %d at most\n", counters->sortedEnqueues, (double) counters->enqueueSteps / MAX(counters->sortedEnqueues, 1), counters->longestEnqueue);
+	fprintf(outFile, "\tready queue depth %d at most, %lld memory allocations, %lld trace bytes\n", counters->maxQueueDepth, summary->allocations, counters->traceBytes);
+}
+
+static ALWAYS_INLINE void end_phase(Info *summary, InstrumentPhase phase, PhaseClock *clock, const Tracer *tracer)
+{
+	unsigned long long now = read_cycles(), traced = tracer != NULL ? tracer->cycles - clock->traceStart : 0;
+
+	summary->instrumentation.cycles[phase] += now - clock->start - traced;				// The next phase starts where this one ends
+	summary->instrumentation.cycles[TRACE_PHASE] += traced;
+	clock->start = now;
+	clock->traceStart += traced;
+}
+
+static void finish_instrumentation(Info *summary, Queue *readyQueue, const Tracer *tracer)
+{
+	Instrumentation *counters = &summary->instrumentation;
+
+	counters->sortedEnqueues = readyQueue->sortedEnqueues;
+	counters->enqueueSteps = readyQueue->enqueueSteps;
+	counters->longestEnqueue = readyQueue->longestEnqueue;
+	counters->maxQueueDepth = readyQueue->maxLength;
+
+	if(tracer == NULL)
+		counters->traceBytes = 0;
+	else if(tracer->async)												// The writer thread's counts are not safe to read until it stops
+		counters->traceBytes = -1;
+	else
+	{
+		counters->traceBytes = tracer->bytesWritten + tracer->textLength;
+		counters->queueCycles = tracer->queueCycles;
+	}
+}
+#endif
+
+double elapsed_seconds(struct timespec *start)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static void store_field(ParseState *state)
+{
+	Process *process;
+
+	if(state->field == 0)									// First field of a process; make room for it
+	{
+		if(state->numOfProcesses == state->capacity)		// Grow the process array geometrically as the file is read
+		{
+			state->capacity = state->capacity == 0 ? 1024 : state->capacity * 2;
+			state->processes = (Process *) realloc(state->processes, sizeof(Process) * state->capacity);
+		}
+
+		state->processes[state->numOfProcesses].ID = state->firstID + state->numOfProcesses;	// Set ID of processes starting from 0
+	}
+
+	process = &state->processes[state->numOfProcesses];
+
+	switch(state->field)									// Fields are burst time, priority and arrival time, in that order
+	{
+		case 0:
+			process->burstTime = state->value;
+			break;
+
+		case 1:
+			process->priority = state->value;
+			break;
+
+		case 2:
+			process->arrivalTime = state->value;
+			state->numOfProcesses++;						// The process is complete once its arrival time is read
+			break;
+	}
+
+	state->field = (state->field + 1) % 3;
+}
+
+void parse_processes(ParseState *state, const char *data, size_t length)
+{
+	for(size_t i = 0; i < length; i++)
 	{
-		while(current->next != NULL && current->next->data->timeRemaining < process->timeRemaining)
-		{
-			current = current->next;				// Progress through the queue until either the end is reached or a longer time remaining is found
-		}
+		unsigned char ch = data[i];
 
-		if(queue->tail == current)						// If the end is reached, the new node will be the new tail
-			queue->tail = newNode;
+		if((ch >= '0' && ch <= '9') || isalnum(ch))			// Numbers are runs of alphanumeric characters; the value is their leading digits, as atoi gives
+		{
+			if(!state->inNumber)
+			{
+				state->inNumber = true;
+				state->inDigits = true;
+				state->value = 0;
+			}
 
-		newNode->next = current->next;					// The new node must point to the next in line and
-		current->next = newNode;						// the previous node must point to the new node
+			if(state->inDigits && ch >= '0' && ch <= '9')
+				state->value = state->value * 10 + (ch - '0');
+			else
+				state->inDigits = false;
+		}
+		else if(state->inNumber)							// Any other character ends the number
+		{
+			state->inNumber = false;
+			store_field(state);
+		}
 	}
+
+	state->bytes += length;
 }
 
-void priority_enqueue_process(Queue *queue, Process *process)
+Process* load_processes(const char *fileName, int *numOfProcesses, ParseStats *stats)
 {
-	Node *current;										// Temporary tracking node to progress through queue
-	Node *newNode = (Node *) malloc(sizeof(Node));		// Allocate new memory to store the new node in the queue
+	ParseState state = { NULL, 0, 0, 0, 0, false, false, 0, 0 };
+	struct timespec start;
+	struct stat info;
+	int fd = strcmp(fileName, "-") == 0 ? STDIN_FILENO : open(fileName, O_RDONLY);		// "-" reads the processes from standard input
 
-	newNode->data = process;							// New node will contain pointer to process and point to NULL
-	newNode->next = NULL;								// as it may become the new tail
+	clock_gettime(CLOCK_MONOTONIC, &start);
 
-	if(is_queue_empty(queue))							// If queue is empty, the new node will be the only node
+	if(fd < 0)
+		return NULL;
+
+	if(fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)	// Regular files are mapped and parsed in place in a single pass
 	{
-		queue->head = newNode;
-		queue->tail = newNode;
-		return;
-	}
+		char *data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
 
-	current = queue->head;								// Start tracking through the queue starting from the head
+		if(data == MAP_FAILED)
+		{
+			close(fd);
+			return NULL;
+		}
 
-	if(queue->head->data->priority > process->priority)		// If first node's priority level is greater than new node's
-	{														// the new node becomes the first node/head
-		newNode->next = queue->head;
-		queue->head = newNode;
+		posix_madvise(data, info.st_size, POSIX_MADV_SEQUENTIAL);
+		parse_processes(&state, data, info.st_size);
+		munmap(data, info.st_size);
 	}
-	else
+	else													// Anything else (pipes, terminals) is read through a large buffer
 	{
-		while(current->next != NULL && current->next->data->priority < process->priority)
-		{
-			current = current->next;					// Progress through the queue until either the end is reached or a greater priority level is found
-		}
+		char *buffer = (char *) malloc(READ_BUFFER_SIZE);
+		ssize_t length;
 
-		if(queue->tail == current)						// If the end is reached, the new node will be the new tail
-			queue->tail = newNode;
+		while((length = read(fd, buffer, READ_BUFFER_SIZE)) > 0)
+			parse_processes(&state, buffer, length);
 
-		newNode->next = current->next;					// The new node must point to the next in line and
-		current->next = newNode;						// the previous node must point to the new node
+		free(buffer);
 	}
+
+	if(state.inNumber)										// The last number may end at the end of the file
+		store_field(&state);
+
+	if(fd != STDIN_FILENO)
+		close(fd);
+
+	if(stats != NULL)
+	{
+		stats->bytes = state.bytes;
+		stats->seconds = elapsed_seconds(&start);
+	}
+
+	*numOfProcesses = state.numOfProcesses;					// An incomplete last line is ignored
+
+	return state.processes;									// Return the pointer to the processes array
 }
 
-int dequeue_process(Queue *queue)
+const char* algorithm_name(Algorithm algo)
 {
-	int ID;											// Holder variable to store ID of first node
-	Node *temp;										// Holder variable to store the data of the first node
+	switch(algo)
+	{
+		case FCFS:
+			return "FCFS";
 
-	if(is_queue_empty(queue))						// If queue is currently empty, return -1 to flag such
-		return -1;
+		case SJF:
+			return "SJF";
 
-	temp = queue->head;								// Set temporary node to point to head
-	ID = temp->data->ID;							// Store the head's ID since it will soon be unavailable
+		case STCF:
+			return "STCF";
 
-	queue->head = queue->head->next;				// Forget the previous head by advancing the head pointer up the list
+		case RR:
+			return "Round Robin";
 
-	free(temp);										// Since the temporary node still points to the original head, we free the memory pointed to by the temporary node
+		case NPP:
+			return "Priority";
 
-	if(queue->head == NULL)							// If the queue only had one node, then signal tail pointer to point to NULL as well to avoid a dangling pointer
-		queue->tail = NULL;
+		case CFS:
+			return "CFS";
+	}
 
-	return ID;										// Return the ID of the original first node
+	return "Unknown";
 }
 
-int peek_queue(Queue *queue)
+RunState* make_run_state(const Process *processes, int numOfProcesses)
 {
-	return queue->head->data->ID;					// Return the ID of the first node in the queue
+	RunState *state = (RunState *) malloc(sizeof(RunState));
+	size_t size = sizeof(int) * (numOfProcesses + 1);
+
+	state->numOfProcesses = numOfProcesses;
+	state->timeRemaining = (int *) malloc(size);
+	state->priority = (int *) malloc(size);
+	state->startTime = (int *) malloc(size);
+	state->lastStart = (int *) malloc(size);
+	state->endTime = (int *) malloc(size);
+	state->vruntime = (long long *) malloc(sizeof(long long) * (numOfProcesses + 1));
+	state->status = (unsigned char *) malloc(numOfProcesses + 1);
+
+	for(int i = 0; i < numOfProcesses; i++)						// Every process starts out new, with its whole burst remaining
+	{
+		state->timeRemaining[i] = processes[i].burstTime;
+		state->priority[i] = processes[i].priority;
+		state->startTime[i] = -1;
+		state->lastStart[i] = -1;
+		state->endTime[i] = -1;
+		state->vruntime[i] = 0;
+		state->status[i] = NEW;
+	}
+
+	return state;
 }
 
-bool is_queue_empty(Queue *queue)
+RunState* copy_run_state(RunState *state)
 {
-	return queue->head == NULL && queue->tail == NULL;		// If the head and tail point to NULL, then the queue is empty
+	RunState *copy = (RunState *) malloc(sizeof(RunState));
+	size_t size = sizeof(int) * (state->numOfProcesses + 1);
+
+	copy->numOfProcesses = state->numOfProcesses;
+	copy->timeRemaining = (int *) malloc(size);
+	copy->priority = (int *) malloc(size);
+	copy->startTime = (int *) malloc(size);
+	copy->lastStart = (int *) malloc(size);
+	copy->endTime = (int *) malloc(size);
+	copy->vruntime = (long long *) malloc(sizeof(long long) * (state->numOfProcesses + 1));
+	copy->status = (unsigned char *) malloc(state->numOfProcesses + 1);
+
+	memcpy(copy->timeRemaining, state->timeRemaining, sizeof(int) * state->numOfProcesses);
+	memcpy(copy->priority, state->priority, sizeof(int) * state->numOfProcesses);
+	memcpy(copy->startTime, state->startTime, sizeof(int) * state->numOfProcesses);
+	memcpy(copy->lastStart, state->lastStart, sizeof(int) * state->numOfProcesses);
+	memcpy(copy->endTime, state->endTime, sizeof(int) * state->numOfProcesses);
+	memcpy(copy->vruntime, state->vruntime, sizeof(long long) * state->numOfProcesses);
+	memcpy(copy->status, state->status, state->numOfProcesses);
+
+	return copy;
 }
 
-void print_queue(FILE *outFile, Queue *queue)
+void destroy_run_state(RunState *state)
 {
-	Node current;										// Temporary tracking node to progress through queue
+	free(state->timeRemaining);									// Destroy/deallocate every array of the run state
+	free(state->priority);
+	free(state->startTime);
+	free(state->lastStart);
+	free(state->endTime);
+	free(state->vruntime);
+	free(state->status);
+
+	free(state);												// Destroy/deallocate the memory reserved for the run state
+	state = NULL;
+}
 
-	if(is_queue_empty(queue))							// If queue is empty, print as such
-	{
-		fprintf(outFile, "Empty\n");
-		return;
-	}
+int cfs_weight(int priority)
+{
+	return cfsWeights[MIN(MAX(priority, -20), 19) + 20];					// Priorities outside the nice range get the weight of the nearest end
+}
 
-	current.data = queue->head->data;					// Start tracking through the queue starting from the head
-	current.next = queue->head->next;
+long long cfs_vruntime(long long base, int ticksRun, int weight)
+{
+	return base + (long long) ticksRun * CFS_TICK_VRUNTIME * CFS_NICE_0_WEIGHT / weight;	// Heavier processes gain virtual runtime more slowly, so they get more ticks
+}
 
-	while(current.next != NULL)							// Progress through the queue until the end is reached
-	{
-		fprintf(outFile, "%d-", current.data->ID);		// Print out the ID's of the processes
-		current.data = current.next->data;
-		current.next = current.next->next;
-	}
+long long cfs_place(Queue *queue, long long runningVruntime)
+{
+	long long least = is_queue_empty(queue) ? runningVruntime : MIN(runningVruntime, queue->leftmost->key);
+
+	if(least != LLONG_MAX)													// Never moved back, so a process placed later never starts behind one placed earlier
+		queue->minVruntime = MAX(queue->minVruntime, least);
 
-	fprintf(outFile, "%d\n", queue->tail->data->ID);	// Print out the tail of the queue; Accounting for a single node queue
+	return queue->minVruntime;
 }
 
-void destroy_queue(Queue *queue)
+int cfs_slice(const Queue *queue, int weight)
 {
-	Node *current = queue->head;						// Progress through the queue starting from the head
+	return (int) MAX(CFS_TARGET_LATENCY * weight / MAX(queue->totalWeight, weight), CFS_MIN_GRANULARITY);	// Share of the target latency, but never too short to be worth a switch
+}
 
-	while(current != NULL)
-	{
-		current = queue->head->next;					// Destroy/deallocate any nodes left in the queue
-		free(queue->head);
-		queue->head = current;
-	}
+bool cfs_preempts(const Queue *queue, long long vruntime, int weight, int ticksRan)
+{
+	long long next = queue->leftmost->key;
+	int slice = cfs_slice(queue, weight);
 
-	free(queue);										// Destroy/deallocate the memory reserved for the queue
-	queue = NULL;
+	return (ticksRan >= slice && vruntime > next) ||						// Slice used up and the head is behind, or far enough behind not to wait for the slice
+		   (ticksRan >= CFS_MIN_GRANULARITY && vruntime - next > (long long) slice * CFS_TICK_VRUNTIME);
 }
 
-LinkedList* make_linked_list()
+static long long ticks_to_pass(long long base, int ticksRun, int weight, long long target)
 {
-	LinkedList *ll = (LinkedList *) malloc(sizeof(LinkedList));
+	long long needed = target - base + 1, ticks;							// Virtual runtime to gain over base before passing target
+
+	if(needed <= 0)
+		return 0;
 
-	ll->head = NULL;									// An empty list will have both head and tail pointing to NULL
-	ll->tail = NULL;
+	ticks = (needed * weight + CFS_TICK_VRUNTIME * CFS_NICE_0_WEIGHT - 1) / (CFS_TICK_VRUNTIME * CFS_NICE_0_WEIGHT);	// Fewest ticks run in all that gain it, rounding up
 
-	return ll;
+	return MAX(ticks - ticksRun, 0);
 }
 
-void add_to_linked_list(LinkedList *ll, int data)
+int cfs_preempt_time(const Queue *queue, long long base, int ticksRun, int weight, int lastStart, int currentTime)
 {
-	LLNode *newNode = (LLNode *) malloc(sizeof(LLNode));	// Allocate new memory to store the new node in the list
+	long long next = queue->leftmost->key, slice = cfs_slice(queue, weight), first = currentTime + 1;	// The queue, and so the slice, stay the same until an event
+	long long bySlice = MAX(lastStart + slice, first + ticks_to_pass(base, ticksRun, weight, next));
+	long long byLag = MAX(lastStart + CFS_MIN_GRANULARITY, first + ticks_to_pass(base, ticksRun, weight, next + slice * CFS_TICK_VRUNTIME));
 
-	newNode->data = data;							// New node will contain pointer to process and point to NULL
-	newNode->next = NULL;							// as it will be the new tail
-
-	if(is_linked_list_empty(ll))					// If list is empty, the new node will be the only node
-	{
-		ll->head = newNode;
-		ll->tail = newNode;
-	}
-	else											// In every other instance, the new node will be the new tail
-	{
-		ll->tail->next = newNode;					// Old tail must point to new tail
-		ll->tail = newNode;							// Tail should point to new node/tail
-	}
+	return (int) MIN(MAX(MIN(bySlice, byLag), first), INT_MAX);
 }
 
-void print_linked_list(FILE *outFile, LinkedList *ll)
+void record_vruntime_spread(Info *summary, const Queue *queue, long long vruntime)
 {
-	LLNode current;									// Temporary tracking node to progress through list
+	long long least = vruntime, greatest = vruntime;
 
-	if(is_linked_list_empty(ll))					// If list is empty, print as such
+	if(queue->root != NULL)													// Least in the queue is the leftmost node, greatest the rightmost
 	{
-		fprintf(outFile, "Empty\n");
-		return;
-	}
+		TreeNode *rightmost = queue->root;
 
-	current.data = ll->head->data;					// Start tracking through the list starting from the head
-	current.next = ll->head->next;
+		while(rightmost->right != NULL)
+			rightmost = rightmost->right;
 
-	while(current.next != NULL)
-	{
-		fprintf(outFile, "%d-", current.data);		// Print out the ID's of the processes
-		current.data = current.next->data;
-		current.next = current.next->next;
+		least = MIN(least, queue->leftmost->key);
+		greatest = MAX(greatest, rightmost->key);
 	}
 
-	fprintf(outFile, "%d\n", ll->tail->data);		// Print out the tail of the list; Accounting for a single node list
+	summary->vruntimeSpreadMax = MAX(summary->vruntimeSpreadMax, greatest - least);
+	summary->vruntimeSpreadSum += greatest - least;
+	summary->vruntimeSamples++;
 }
 
-bool is_linked_list_empty(LinkedList *ll)
+static ALWAYS_INLINE long long current_vruntime(const Process *processes, const RunState *state, int ID)
 {
-	return ll->head == NULL && ll->tail == NULL;	// If either the head and tail point to NULL, then the list is empty
+	if(ID == -1)															// No process at all is never the least
+		return LLONG_MAX;
+
+	return cfs_vruntime(state->vruntime[ID], processes[ID].burstTime - state->timeRemaining[ID], cfs_weight(processes[ID].priority));
 }
 
-void destroy_linked_list(LinkedList *ll)
+static ALWAYS_INLINE int next_event_time(AdmissionIndex *index, const Process *processes, RunState *state, Queue *readyQueue, int activeProcess, int currentTime, const Algorithm algo, const SimConfig *config)
 {
-	LLNode *current= ll->head;						// Progress through the queue starting from the head
+	int nextTime = next_arrival_time(index, processes);	// Earliest tick at which the outcome of a tick can differ from simply running/idling; the next arrival may cause loading or preemption
 
-	while(current != NULL)
+	if(index->numWaiting > 0)							// A preempted process is put back into the ready queue on the very next tick
+		return currentTime + 1;
+
+	if(activeProcess != -1)
 	{
-		current = ll->head->next;
-		free(ll->head);								// Destroy/deallocate any nodes left in the queue
-		ll->head = current;	
+		if(currentTime + 1 + MAX(state->timeRemaining[activeProcess], 0) < nextTime)		// Tick at which the running process is found finished
+			nextTime = currentTime + 1 + MAX(state->timeRemaining[activeProcess], 0);
+
+		if(algo == RR && !is_queue_empty(readyQueue) && MAX(currentTime + 1, state->lastStart[activeProcess] + config->quantum) < nextTime)	// Quantum expiry with someone waiting to take over
+			nextTime = MAX(currentTime + 1, state->lastStart[activeProcess] + config->quantum);
+
+		if(algo == CFS && !is_queue_empty(readyQueue))	// Virtual runtime passing the head's, once the process has had its slice or is too far ahead
+			nextTime = MIN(nextTime, cfs_preempt_time(readyQueue, state->vruntime[activeProcess], processes[activeProcess].burstTime - state->timeRemaining[activeProcess],
+													  cfs_weight(processes[activeProcess].priority), state->lastStart[activeProcess], currentTime));
 	}
 
-	free(ll);										// Destroy/deallocate the memory reserved for the list
-	ll = NULL;										// Set pointer to NULL to avoid dangling pointer
+	if(nextTime == INT_MAX)								// Should not happen while processes remain, but never stall the simulation
+		nextTime = currentTime + 1;
+
+	return nextTime;
 }
 
-Info* make_info()
+static ALWAYS_INLINE void skip_ticks(Tracer *tracer, RunState *state, Queue *readyQueue, int activeProcess, int fromTime, int toTime, const bool traced)
 {
-	Info* information = (Info *) malloc(sizeof(Info));
-
-	information->avgWaitTime = 0;
-	information->avgTurnaroundTime = 0;
-	information->processSequence = make_linked_list();		// Piggyback initialize function for included list
-	information->contextSwitches = 0;
+	if(traced)																	// Print out the info for each interval, exactly as the tick-by-tick simulation would
+		trace_span(tracer, activeProcess == -1 ? IDLE_RECORD : RUN_RECORD, fromTime, toTime, activeProcess, activeProcess == -1 ? 0 : state->timeRemaining[activeProcess], -1, 0, readyQueue);
 
-	return information;
+	if(activeProcess != -1 && toTime > fromTime)
+		state->timeRemaining[activeProcess] -= toTime - fromTime;						// The running process executed every skipped tick
 }
 
-void destroy_info(Info *information)
+Simulation* start_simulation(const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config)
 {
-	destroy_linked_list(information->processSequence);		// Piggyback destroy function for included list
+	Simulation *sim;
+
+	if(config->numOfCpus > 1)																// Only the single CPU simulation can be stopped part way through
+		return NULL;
+
+	sim = (Simulation *) malloc(sizeof(Simulation));
+
+	sim->processes = processes;
+	sim->ownProcesses = NULL;
+	sim->numOfProcesses = numOfProcesses;
+	sim->algo = algo;
+	sim->config = *config;
+	sim->currentTime = 0;																	// Simulation Time, Number of processes that have been completed, the PID of the currently running process
+	sim->processesComplete = 0;
+	sim->activeProcess = -1;
+	sim->summary = make_info(numOfProcesses);												// The information pertaining to the current simulation of the selected algorithm
+	sim->state = make_run_state(processes, numOfProcesses);								// Everything the simulation changes about the processes, starting fresh for every algorithm
+
+	if(SORTED_QUEUE_TYPE == HEAP_QUEUE && (algo == SJF || algo == STCF || algo == NPP))	// Sorted ready queues may be backed by a heap; FIFO ready queues stay linked lists
+		sim->readyQueue = make_heap_queue();
+	else if(algo == CFS)																	// CFS always orders by virtual runtime in a tree
+		sim->readyQueue = make_tree_queue();
+	else
+		sim->readyQueue = make_queue();
 
-	free(information);										// Destroy/deallocate the memory reserved for the info type
-	information = NULL;										// Set pointer to NULL to avoid dangling pointer
+	sim->admission = make_admission_index(processes, numOfProcesses);					// Processes sorted by arrival, plus the preempted ones waiting to be put back
+
+	return sim;
 }
 
-int find_num_of_processes(FILE *inFile)
+Simulation* snapshot_simulation(const Simulation *sim)
 {
-	int numOfProcesses = 0;					// Variable for finding number of processes detailed in the input file
-	char ch;								// Holder variable for getc conversion
+	Simulation *copy = (Simulation *) malloc(sizeof(Simulation));
+
+	*copy = *sim;
+	copy->summary = copy_info(sim->summary);
+	copy->state = copy_run_state(sim->state);
+	copy->readyQueue = copy_queue(sim->readyQueue);
+	copy->admission = copy_admission_index(sim->admission);
 
-	while (!feof(inFile))					// Read file until the end of file (EOF)
+	if(sim->ownProcesses != NULL)															// A fork's changed processes go with its snapshots
 	{
-		ch = fgetc(inFile);					// Store character into holder variable
-		if(!isalnum(ch) && ch != ' ')		// Increment the number of processes variable when a new-line character is found
-			numOfProcesses++;
+		copy->ownProcesses = (Process *) malloc(sizeof(Process) * (sim->numOfProcesses + 1));
+		memcpy(copy->ownProcesses, sim->ownProcesses, sizeof(Process) * sim->numOfProcesses);
+		copy->processes = copy->ownProcesses;
 	}
 
-	rewind(inFile);							// Rewind the input file back to the beginning for future reading
-
-	return numOfProcesses;
+	return copy;
 }
 
-Process* load_processes(FILE *inFile, int numOfProcesses)
+Simulation* fork_simulation(const Simulation *sim, const Process *processes)
 {
-	int charCount = 0;						// Counter variable for current size of the buffer
-	char buffer[255];						// Buffer string to hold the numeric characters stored in the input file
-
-	Process *processes = (Process *) malloc(sizeof(Process) * numOfProcesses);	// Dynamically allocate space for all processes
+	Simulation *fork;
+	AdmissionIndex *admission;
 
-	for(int i = 0; i < numOfProcesses; i++)
+	for(int i = 0; i < sim->numOfProcesses; i++)											// Only processes that have not arrived yet, before or after the change, may change
 	{
-		processes[i].ID = i;												// Set ID of processes starting from 0
-
-		charCount = 0;
-		for(int j = 0; j < 255; j++)										// Clear the buffer, also ensures string ends in NULL character '\0' for proper string printing
-			buffer[j] = '\0';
-		while(!isalnum(fgetc(inFile)));
-		fseek(inFile, -1, SEEK_CUR);
+		const Process *before = &sim->processes[i], *after = &processes[i];
 
-		while(isalnum(fgetc(inFile)))										// Put characters into buffer until white-space character is found
-		{
-			fseek(inFile, -1, SEEK_CUR);
-			buffer[charCount] = fgetc(inFile);
-			charCount++;
-		}
-		processes[i].burstTime = atoi(buffer);								// Convert buffer string into integer and store as the burst time for process
+		if(memcmp(before, after, sizeof(Process)) != 0 && (before->arrivalTime < sim->currentTime || after->arrivalTime < sim->currentTime))
+			return NULL;
+	}
 
-		charCount = 0;
-		for(int j = 0; j < 255; j++)
-			buffer[j] = '\0';												// Clear the buffer and ensure string ends in NULL character
-		while(!isalnum(fgetc(inFile)));
-		fseek(inFile, -1, SEEK_CUR);										// Read characters until no more white-space is found
+	fork = snapshot_simulation(sim);
 
-		while(isalnum(fgetc(inFile)))										// Put characters into buffer until white-space is found again
-		{
-			fseek(inFile, -1, SEEK_CUR);
-			buffer[charCount] = fgetc(inFile);
-			charCount++;
-		}
-		processes[i].priority = atoi(buffer);								// Convert buffer string into integer and store as the priority for process
+	free(fork->ownProcesses);
+	fork->ownProcesses = (Process *) malloc(sizeof(Process) * (sim->numOfProcesses + 1));
+	memcpy(fork->ownProcesses, processes, sizeof(Process) * sim->numOfProcesses);
+	fork->processes = fork->ownProcesses;
 
-		charCount = 0;
-		for(int j = 0; j < 255; j++)
-			buffer[j] = '\0';												// Clear the buffer and ensure string ends in NULL character
-		while(!isalnum(fgetc(inFile)));
-		fseek(inFile, -1, SEEK_CUR);										// Read characters until no more white-space is found
+	admission = make_admission_index(fork->processes, fork->numOfProcesses);				// Everything that has arrived sorts the same as before, so only the cursor carries over
+	admission->cursor = fork->admission->cursor;
+	for(int i = 0; i < fork->admission->numWaiting; i++)
+		add_waiting_process(admission, fork->admission->waiting[i]);
+	destroy_admission_index(fork->admission);
+	fork->admission = admission;
 
-		while(isalnum(fgetc(inFile)))										// Put characters into buffer until white-space or end of file is found
+	for(int i = 0; i < fork->numOfProcesses; i++)											// Processes yet to arrive start from their changed burst and priority
+	{
+		if(fork->state->status[i] == NEW)
 		{
-			fseek(inFile, -1, SEEK_CUR);
-			buffer[charCount] = fgetc(inFile);
-			charCount++;
+			fork->state->timeRemaining[i] = fork->processes[i].burstTime;
+			fork->state->priority[i] = fork->processes[i].priority;
 		}
-		buffer[charCount] = '\0';
-		processes[i].arrivalTime = atoi(buffer);							// Convert buffer string into integer and store as arrival time for process
 	}
 
-	return processes;														// Return the pointer to the processes array
+	return fork;
 }
 
-Info* simulate(FILE *outFile, int interval, Process *processes, int numOfProcesses, Algorithm algo)
+void destroy_simulation(Simulation *sim)
 {
-	int currentTime = 0, processesComplete = 0, activeProcess = -1;							// Simulation Time, Number of processes that have been completed, the PID of the currently running process
-	Info *summary = make_info();															// The information pertaining to the current simulation of the selected algorithm
-	Queue *readyQueue = make_queue();														// The ready queue - contains pointers to processes that are ready to be run
+	if(sim->summary != NULL)
+		destroy_info(sim->summary);
 
-	for (int i = 0; i < numOfProcesses; i++)												// Resetting auxillary variables for processes for proper simulation of multiple algorithms
-	{
-		processes[i].timeRemaining = processes[i].burstTime;
-		processes[i].startTime = -1;
-		processes[i].lastStart = -1;
-		processes[i].endTime = -1;
-		processes[i].turnaroundTime = -1;
-		processes[i].waitTime = -1;
-		processes[i].status = NEW;
-	}
+	destroy_run_state(sim->state);
+	destroy_queue(sim->readyQueue);
+	destroy_admission_index(sim->admission);
+	free(sim->ownProcesses);
+
+	free(sim);																				// Destroy/deallocate the memory reserved for the simulation
+	sim = NULL;
+}
+
+static Info* take_results(Simulation *sim)
+{
+	Info *summary = sim->summary;
 
-	switch(algo)															// Print out title for each type of algorithm
+	summary->avgTurnaroundTime /= sim->numOfProcesses;										// Wait and turnaround times were summed up as each process finished
+	summary->avgWaitTime /= sim->numOfProcesses;											// Calculate the average wait and turnaroudn time for current algorithm
+
+	sim->summary = NULL;																	// The results outlive the rest of the simulation
+	destroy_simulation(sim);
+
+	return summary;
+}
+
+void print_title(FILE *outFile, Algorithm algo)
+{
+	switch(outFile != NULL ? algo : -1)										// Print out title for each type of algorithm, unless nothing is printed at all
 	{
 		case FCFS:
 			fprintf(outFile, "***** FCFS Scheduling *****\n");
@@ -430,201 +1695,373 @@ Info* simulate(FILE *outFile, int interval, Process *processes, int numOfProcess
 		case NPP:
 			fprintf(outFile, "***** Priority Scheduling *****\n");
 			break;
+
+		case CFS:
+			fprintf(outFile, "***** CFS Scheduling *****\n");
+			break;
 	}
+}
 
-	while(processesComplete < numOfProcesses)		// Main simulation loop;  Ends when all processes are complete
+static ALWAYS_INLINE void run_loop(Simulation *sim, Tracer *tracer, int stopTime, const Algorithm algo, const bool traced)
+{
+	int currentTime = sim->currentTime, nextTime, processesComplete = sim->processesComplete, activeProcess = sim->activeProcess;	// Time of the next event; the rest carries on from where the simulation stopped
+	const Process *processes = sim->processes;
+	int numOfProcesses = sim->numOfProcesses;
+	const SimConfig *config = &sim->config;
+	Info *summary = sim->summary;
+	RunState *state = sim->state;
+	Queue *readyQueue = sim->readyQueue;													// The ready queue - contains the IDs of processes that are ready to be run
+	AdmissionIndex *admission = sim->admission;
+	int position;																			// Ready queue position a process entered a tree queue at
+	INSTRUMENT(PhaseClock clock = { read_cycles(), tracer != NULL ? tracer->cycles : 0 };)
+
+	while(processesComplete < numOfProcesses && currentTime < stopTime)		// Main simulation loop;  Ends when all processes are complete, or at the stop time
 	{
-		for(int i = 0; i < numOfProcesses; i++)									// Scan through processes and add proper processes to ready queue according to different algorithms
+		INSTRUMENT(summary->instrumentation.events++;)
+		begin_admissions(admission, processes, currentTime);						// Only processes arriving now or returning from preemption are looked at
+
+		for(int i = next_admission(admission); i != -1; i = next_admission(admission))	// Add proper processes to ready queue according to different algorithms
 		{
-			if(currentTime >= processes[i].arrivalTime)
-			{
-				if(algo == NPP && processes[i].status == WAITING && (currentTime - processes[i].lastStart) % 25 == 0)		// Implement aging by increasing (decrementing) prirority in priority scheduling
-					processes[i].priority--;
+			if(algo == NPP && state->status[i] == WAITING && (currentTime - state->lastStart[i]) % config->agingPeriod == 0)		// Implement aging by increasing (decrementing) prirority in priority scheduling
+				state->priority[i]--;
 
-				if(processes[i].status == NEW || processes[i].status == WAITING)			// Processes should only be added if they are either new processes or processes that were preempted (waiting)
-				{
-					switch(algo)
-					{
-						case FCFS: case RR:
-								enqueue_process(readyQueue, &processes[i]);					// Simple enqueue for FCFS; Processes should only be in NEW status for FCFS; Process should only be in NEW or WAIT status for RR
-								processes[i].status = READY;
-							break;
-
-						case SJF:
-								burst_time_enqueue_process(readyQueue, &processes[i]);		// Enqueue while ordering shortest burst time first;  Processes should only be in NEW status for SJF
-								processes[i].status = READY;
-							break;
-
-						case STCF:
-								time_remaining_enqueue_process(readyQueue, &processes[i]);	// Enqueue while ordering shortest time remaining first; Processes should be in either NEW or WAIT status for STCF
-								processes[i].status = READY;
-							break;
-
-						case NPP:
-								priority_enqueue_process(readyQueue, &processes[i]);		// Enqueue while ordering lowest priority level first;  Processes should only be in NEW status for non-preemptive priority
-								processes[i].status = READY;
-							break;
-					}
-				}
+			switch(algo)															// Processes are only admitted if they are either new processes or processes that were preempted (waiting)
+			{
+				case FCFS: case RR:
+						enqueue_process(readyQueue, i);								// Simple enqueue for FCFS; Processes should only be in NEW status for FCFS; Process should only be in NEW or WAIT status for RR
+						if(traced)
+							trace_enqueue(tracer, i, 0, false);
+						state->status[i] = READY;
+					break;
+
+				case SJF:
+						sorted_enqueue_process(readyQueue, i, processes[i].burstTime);	// Enqueue while ordering shortest burst time first;  Processes should only be in NEW status for SJF
+						if(traced)
+							trace_enqueue(tracer, i, processes[i].burstTime, true);
+						state->status[i] = READY;
+					break;
+
+				case STCF:
+						sorted_enqueue_process(readyQueue, i, state->timeRemaining[i]);	// Enqueue while ordering shortest time remaining first; Processes should be in either NEW or WAIT status for STCF
+						if(traced)
+							trace_enqueue(tracer, i, state->timeRemaining[i], true);
+						state->status[i] = READY;
+					break;
+
+				case NPP:
+						sorted_enqueue_process(readyQueue, i, state->priority[i]);		// Enqueue while ordering lowest priority level first;  Processes should only be in NEW status for non-preemptive priority
+						if(traced)
+							trace_enqueue(tracer, i, state->priority[i], true);
+						state->status[i] = READY;
+					break;
+
+				case CFS:
+						if(state->status[i] == NEW)										// New processes start level with the least virtual runtime, so they neither wait behind
+						{																// everyone nor take over the CPU; Preempted processes keep their virtual runtime
+							state->vruntime[i] = cfs_place(readyQueue, current_vruntime(processes, state, activeProcess));
+							readyQueue->totalWeight += cfs_weight(processes[i].priority);
+						}
+
+						position = tree_enqueue_process(readyQueue, i, current_vruntime(processes, state, i));	// Enqueue while ordering least virtual runtime first
+						if(traced)
+							trace_insert(tracer, i, position);
+						state->status[i] = READY;
+					break;
 			}
 		}
-		
+
+		INSTRUMENT(end_phase(summary, ADMIT_PHASE, &clock, tracer);)
+
 		if(activeProcess == -1 && !is_queue_empty(readyQueue))						// Loading first process
 		{
-			if(currentTime % interval == 0)											// Print out info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Loading Process %d (CPU Burst = %d)\n", peek_queue(readyQueue), processes[peek_queue(readyQueue)].burstTime);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
+			if(traced)														// Print out info for each interval
+				trace_span(tracer, LOAD_RECORD, currentTime, currentTime + 1, -1, 0, peek_queue(readyQueue), processes[peek_queue(readyQueue)].burstTime, readyQueue);
 
 			activeProcess = dequeue_process(readyQueue);							// Pull first process from ready queue				
-			processes[activeProcess].status = RUNNING;								// Set process as running
-			processes[activeProcess].startTime = currentTime;						// Set start time for first process
-			processes[activeProcess].lastStart = currentTime;						// Set last time process was started for round robin scheduling
-			processes[activeProcess].timeRemaining--;								// Decrement time remaining for currently running process
+			if(traced)
+				trace_dequeue(tracer);
+			state->status[activeProcess] = RUNNING;								// Set process as running
+			state->startTime[activeProcess] = currentTime;						// Set start time for first process
+
+			if(state->timeRemaining[activeProcess] == processes[activeProcess].burstTime)
+				record_value(&summary->latency.response, currentTime - processes[activeProcess].arrivalTime);	// First time the process runs
+			state->lastStart[activeProcess] = currentTime;						// Set last time process was started for round robin scheduling
+			state->timeRemaining[activeProcess]--;								// Decrement time remaining for currently running process
 			summary->contextSwitches++;												// Increment number of context switches
-			add_to_linked_list(summary->processSequence, activeProcess);			// Add process to sequence list
+			add_to_timeline(summary->processSequence, activeProcess, currentTime);	// Add process to sequence timeline
 		}
 
 		else if(activeProcess == -1 && is_queue_empty(readyQueue))					// No process running, and no processes in the ready queue
 		{
-			if(currentTime % interval == 0)											// Print out the info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Idle, Waiting for a Process\n");
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
+			if(traced)														// Print out the info for each interval
+				trace_span(tracer, IDLE_RECORD, currentTime, currentTime + 1, -1, 0, -1, 0, readyQueue);
 		}
 
-		else if(processes[activeProcess].timeRemaining <= 0 && !is_queue_empty(readyQueue))		// Loading in next process - when one process finishes, another begins
+		else if(state->timeRemaining[activeProcess] <= 0 && !is_queue_empty(readyQueue))		// Loading in next process - when one process finishes, another begins
 		{
-			if(currentTime % interval == 0)														// Print out info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Finishing Process %d; Loading Process %d (CPU Burst = %d)\n", activeProcess, peek_queue(readyQueue), processes[peek_queue(readyQueue)].timeRemaining);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
-
-			processes[activeProcess].status = TERMINATED;										// Set completed process as terminated
-			processes[activeProcess].endTime = currentTime;										// Set end time for completed process
+			if(traced)																	// Print out info for each interval
+				trace_span(tracer, FINISH_LOAD_RECORD, currentTime, currentTime + 1, activeProcess, 0, peek_queue(readyQueue), state->timeRemaining[peek_queue(readyQueue)], readyQueue);
+
+			state->status[activeProcess] = TERMINATED;										// Set completed process as terminated
+			state->endTime[activeProcess] = currentTime;										// Set end time for completed process
+			record_finished_process(summary, activeProcess, currentTime - processes[activeProcess].arrivalTime, processes[activeProcess].burstTime);
+			if(algo == CFS)
+				readyQueue->totalWeight -= cfs_weight(processes[activeProcess].priority);		// Finished processes no longer share the CPU
 			processesComplete++;																// Increment number of completed processes
 			activeProcess = dequeue_process(readyQueue);										// Pull next process from ready queue
-			processes[activeProcess].status = RUNNING;											// Set new process to running
+			if(traced)
+				trace_dequeue(tracer);
+			state->status[activeProcess] = RUNNING;											// Set new process to running
 
-			if(processes[activeProcess].timeRemaining == processes[activeProcess].burstTime)
-				processes[activeProcess].startTime = currentTime;								// Set start time for new process, not for a preempted one
+			if(state->timeRemaining[activeProcess] == processes[activeProcess].burstTime)
+			{
+				state->startTime[activeProcess] = currentTime;								// Set start time for new process, not for a preempted one
+				record_value(&summary->latency.response, currentTime - processes[activeProcess].arrivalTime);
+			}
 
-			processes[activeProcess].lastStart = currentTime;									// Set last time process was started for round robin scheduling
-			processes[activeProcess].timeRemaining--;											// Decrement time remaining for currently running process
+			state->lastStart[activeProcess] = currentTime;									// Set last time process was started for round robin scheduling
+			state->timeRemaining[activeProcess]--;											// Decrement time remaining for currently running process
 			summary->contextSwitches++;															// Increment number of context switches
-			add_to_linked_list(summary->processSequence, activeProcess);						// Add new process to sequence list
+			add_to_timeline(summary->processSequence, activeProcess, currentTime);				// Add new process to sequence timeline
 		}
 
-		else if(processes[activeProcess].timeRemaining <= 0 && is_queue_empty(readyQueue))		// Finishing last process; When all processes are done, the ready queue will be empty
+		else if(state->timeRemaining[activeProcess] <= 0 && is_queue_empty(readyQueue))		// Finishing last process; When all processes are done, the ready queue will be empty
 		{
-			if(currentTime % interval == 0)											// Print out info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Finishing Process %d\n", activeProcess);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
-
-			processes[activeProcess].status = TERMINATED;							// Set last process as terminated
-			processes[activeProcess].endTime = currentTime;							// Set end time for last process
+			if(traced)														// Print out info for each interval
+				trace_span(tracer, FINISH_RECORD, currentTime, currentTime + 1, activeProcess, 0, -1, 0, readyQueue);
+
+			state->status[activeProcess] = TERMINATED;							// Set last process as terminated
+			state->endTime[activeProcess] = currentTime;							// Set end time for last process
+			record_finished_process(summary, activeProcess, currentTime - processes[activeProcess].arrivalTime, processes[activeProcess].burstTime);
+			if(algo == CFS)
+				readyQueue->totalWeight -= cfs_weight(processes[activeProcess].priority);
+			end_timeline(summary->processSequence, currentTime);					// CPU goes idle until the next process is loaded
 			processesComplete++;													// Increment number of completed processes
 			activeProcess = -1;														// Reset active process holder variable
 		}
 
-		else if(algo == STCF && !is_queue_empty(readyQueue) && processes[activeProcess].timeRemaining > processes[peek_queue(readyQueue)].timeRemaining)		// STCF preemption - the next process in the ready queue should have the lowest time remaining
+		else if(algo == STCF && !is_queue_empty(readyQueue) && state->timeRemaining[activeProcess] > state->timeRemaining[peek_queue(readyQueue)])		// STCF preemption - the next process in the ready queue should have the lowest time remaining
 		{
-			if(currentTime % interval == 0)											// Print out the info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Preempting Process %d (Remaining CPU Burst = %d); Loading Process %d (CPU Burst = %d)\n", activeProcess, processes[activeProcess].timeRemaining, peek_queue(readyQueue), processes[peek_queue(readyQueue)].timeRemaining);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
+			if(traced)														// Print out the info for each interval
+				trace_span(tracer, PREEMPT_RECORD, currentTime, currentTime + 1, activeProcess, state->timeRemaining[activeProcess], peek_queue(readyQueue), state->timeRemaining[peek_queue(readyQueue)], readyQueue);
 
-			processes[activeProcess].status = WAITING;											// Set preempted process to waiting
+			state->status[activeProcess] = WAITING;											// Set preempted process to waiting
+			add_waiting_process(admission, activeProcess);										// It goes back into the ready queue on the next tick
 			activeProcess = dequeue_process(readyQueue);										// Load in the next process
-			processes[activeProcess].status = RUNNING;											// Set new process as running
+			if(traced)
+				trace_dequeue(tracer);
+			state->status[activeProcess] = RUNNING;											// Set new process as running
 
-			if(processes[activeProcess].timeRemaining == processes[activeProcess].burstTime)
-				processes[activeProcess].startTime = currentTime;								// Set start time for new process, not for a preempted one
+			if(state->timeRemaining[activeProcess] == processes[activeProcess].burstTime)
+			{
+				state->startTime[activeProcess] = currentTime;								// Set start time for new process, not for a preempted one
+				record_value(&summary->latency.response, currentTime - processes[activeProcess].arrivalTime);
+			}
 
-			processes[activeProcess].lastStart = currentTime;									// Set last time process was started
-			processes[activeProcess].timeRemaining--;
+			state->lastStart[activeProcess] = currentTime;									// Set last time process was started
+			state->timeRemaining[activeProcess]--;
 			summary->contextSwitches++;															// Increment number of context switches
-			add_to_linked_list(summary->processSequence, activeProcess);						// Add process to sequence list
+			add_to_timeline(summary->processSequence, activeProcess, currentTime);				// Add process to sequence timeline
 		}
 
-		else if(algo == RR && !is_queue_empty(readyQueue) && currentTime - processes[activeProcess].lastStart >= QUANTUM)		// Round robin preemption - when the process has run for as long  as (or longer than) the quantum
+		else if(!is_queue_empty(readyQueue) && ((algo == RR && currentTime - state->lastStart[activeProcess] >= config->quantum) ||		// Round robin preemption - when the process has run for as long  as (or longer than) the quantum
+												(algo == CFS && cfs_preempts(readyQueue, current_vruntime(processes, state, activeProcess), cfs_weight(processes[activeProcess].priority),
+																			 currentTime - state->lastStart[activeProcess]))))	// CFS preemption - when the head is owed the CPU
 		{
-			if(currentTime % interval == 0)														// Print out the info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Preempting Process %d (Remaining CPU Burst = %d); Loading Process %d (CPU Burst = %d)\n", activeProcess, processes[activeProcess].timeRemaining, peek_queue(readyQueue), processes[peek_queue(readyQueue)].timeRemaining);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
-			processes[activeProcess].status = WAITING;											// Set preempted process to waiting
+			if(traced)																	// Print out the info for each interval
+				trace_span(tracer, PREEMPT_RECORD, currentTime, currentTime + 1, activeProcess, state->timeRemaining[activeProcess], peek_queue(readyQueue), state->timeRemaining[peek_queue(readyQueue)], readyQueue);
+			state->status[activeProcess] = WAITING;											// Set preempted process to waiting
+			add_waiting_process(admission, activeProcess);										// It goes back into the ready queue on the next tick
 			activeProcess = dequeue_process(readyQueue);										// Load in next process
-			processes[activeProcess].status = RUNNING;											// Set new process as running
+			if(traced)
+				trace_dequeue(tracer);
+			state->status[activeProcess] = RUNNING;											// Set new process as running
 
-			if(processes[activeProcess].timeRemaining == processes[activeProcess].burstTime)
-				processes[activeProcess].startTime = currentTime;								// Set start time for new process, not for a preempted one
+			if(state->timeRemaining[activeProcess] == processes[activeProcess].burstTime)
+			{
+				state->startTime[activeProcess] = currentTime;								// Set start time for new process, not for a preempted one
+				record_value(&summary->latency.response, currentTime - processes[activeProcess].arrivalTime);
+			}
 
-			processes[activeProcess].lastStart = currentTime;									// Set last time process was started
-			processes[activeProcess].timeRemaining--;
+			state->lastStart[activeProcess] = currentTime;									// Set last time process was started
+			state->timeRemaining[activeProcess]--;
 			summary->contextSwitches++;															// Increment number of context switches
-			add_to_linked_list(summary->processSequence, activeProcess);						// Add process to sequence list
+			add_to_timeline(summary->processSequence, activeProcess, currentTime);				// Add process to sequence timeline
 		}
 
 		else																					// Simple process execution, no finishing of a process, no loading of a new process, no preemption
 		{
-			if(currentTime % interval == 0)														// Print out the info for each interval
-			{
-				fprintf(outFile, "t = %d\n", currentTime);
-				fprintf(outFile, "CPU: Running Process %d (Remaining CPU Burst = %d)\n", activeProcess, processes[activeProcess].timeRemaining);
-				fprintf(outFile, "Ready Queue: ");
-				print_queue(outFile, readyQueue);
-				fprintf(outFile, "\n");
-			}
-			processes[activeProcess].timeRemaining--;										// Decrement time remaining for currently running process
+			if(traced)																	// Print out the info for each interval
+				trace_span(tracer, RUN_RECORD, currentTime, currentTime + 1, activeProcess, state->timeRemaining[activeProcess], -1, 0, readyQueue);
+			state->timeRemaining[activeProcess]--;										// Decrement time remaining for currently running process
 		}
 
-		currentTime++;																		// Increment time to progress simulation
+		if(algo == CFS && activeProcess != -1 && state->lastStart[activeProcess] == currentTime)	// Fairness is sampled whenever a process is loaded, after its first tick
+			record_vruntime_spread(summary, readyQueue, current_vruntime(processes, state, activeProcess));
+
+		INSTRUMENT(end_phase(summary, DISPATCH_PHASE, &clock, tracer);)
+
+		if(processesComplete == numOfProcesses)												// Nothing left to schedule after the last process finishes
+			break;
+
+		nextTime = MIN(next_event_time(admission, processes, state, readyQueue, activeProcess, currentTime, algo, config), stopTime);	// Jump straight to the next tick where something can change
+
+		skip_ticks(tracer, state, readyQueue, activeProcess, currentTime + 1, nextTime, traced);		// Account for (and print) the uneventful ticks in between
+		INSTRUMENT(end_phase(summary, ADVANCE_PHASE, &clock, tracer);)
+
+		currentTime = nextTime;																// Advance time to progress simulation
 	}
 
-	for(int i = 0; i < numOfProcesses; i++)													// Calculate the wait and turnaround times for each process
+	sim->currentTime = currentTime;
+	sim->processesComplete = processesComplete;
+	sim->activeProcess = activeProcess;
+
+	summary->nodeRequests = readyQueue->nodePool.requests;										// Record how many nodes were used and how many times memory had to be allocated for them
+	summary->allocations = readyQueue->nodePool.allocations + readyQueue->heapAllocations + summary->processSequence->allocations;
+
+	summary->endTime = currentTime;															// Record when the last process finished
+	INSTRUMENT(finish_instrumentation(summary, readyQueue, tracer);)
+}
+
+static void run_fcfs(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)																		// Untraced runs get a loop with no tracing in it at all
+		run_loop(sim, NULL, stopTime, FCFS, false);
+	else
+		run_loop(sim, tracer, stopTime, FCFS, true);												// Simulation loop compiled with FCFS decisions only
+}
+
+static void run_sjf(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)
+		run_loop(sim, NULL, stopTime, SJF, false);
+	else
+		run_loop(sim, tracer, stopTime, SJF, true);												// Simulation loop compiled with SJF decisions only
+}
+
+static void run_stcf(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)
+		run_loop(sim, NULL, stopTime, STCF, false);
+	else
+		run_loop(sim, tracer, stopTime, STCF, true);												// Simulation loop compiled with STCF decisions only
+}
+
+static void run_rr(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)
+		run_loop(sim, NULL, stopTime, RR, false);
+	else
+		run_loop(sim, tracer, stopTime, RR, true);												// Simulation loop compiled with round robin decisions only
+}
+
+static void run_npp(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)
+		run_loop(sim, NULL, stopTime, NPP, false);
+	else
+		run_loop(sim, tracer, stopTime, NPP, true);												// Simulation loop compiled with priority scheduling decisions only
+}
+
+static void run_cfs(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	if(tracer == NULL)
+		run_loop(sim, NULL, stopTime, CFS, false);
+	else
+		run_loop(sim, tracer, stopTime, CFS, true);												// Simulation loop compiled with CFS decisions only
+}
+
+void init_sim_config(SimConfig *config)
+{
+	config->quantum = QUANTUM;
+	config->agingPeriod = AGING_PERIOD;
+	config->numOfCpus = 1;
+}
+
+Info* simulate(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo)
+{
+	SimConfig config;
+
+	init_sim_config(&config);
+
+	return simulate_config(outFile, tracer, processes, numOfProcesses, algo, &config);
+}
+
+static void run_specialized(Simulation *sim, Tracer *tracer, int stopTime)
+{
+	switch(sim->algo)																		// Pick the loop specialized for the algorithm, so the loop itself never checks which algorithm it runs
 	{
-		processes[i].turnaroundTime = processes[i].endTime - processes[i].arrivalTime;
-		processes[i].waitTime = processes[i].turnaroundTime - processes[i].burstTime;
+		case FCFS:
+			run_fcfs(sim, tracer, stopTime);
+			break;
+
+		case SJF:
+			run_sjf(sim, tracer, stopTime);
+			break;
+
+		case STCF:
+			run_stcf(sim, tracer, stopTime);
+			break;
+
+		case RR:
+			run_rr(sim, tracer, stopTime);
+			break;
+
+		case NPP:
+			run_npp(sim, tracer, stopTime);
+			break;
+
+		case CFS:
+			run_cfs(sim, tracer, stopTime);
+			break;
 
-		summary->avgTurnaroundTime += processes[i].turnaroundTime;							// Sum up wait and turnaround times for averaging purposes
-		summary->avgWaitTime += processes[i].waitTime;
+		default:
+			run_loop(sim, tracer, stopTime, sim->algo, tracer != NULL);
 	}
+}
 
-	summary->avgTurnaroundTime /= numOfProcesses;
-	summary->avgWaitTime /= numOfProcesses;													// Calculate the average wait and turnaroudn time for current algorithm
+bool run_simulation(Simulation *sim, int stopTime)
+{
+	run_specialized(sim, NULL, stopTime);
 
-	destroy_queue(readyQueue);
-	
-	return summary;
+	return sim->processesComplete == sim->numOfProcesses;
+}
+
+Info* finish_simulation(Simulation *sim)
+{
+	run_specialized(sim, NULL, INT_MAX);
+
+	return take_results(sim);
+}
+
+Info* simulate_config(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config)
+{
+	Simulation *sim;
+
+	if(config->numOfCpus > 1)																// Multi-CPU simulations have their own loop, and no interval trace
+		return simulate_smp(outFile, processes, numOfProcesses, algo, config);
+
+	sim = start_simulation(processes, numOfProcesses, algo, config);
+	print_title(outFile, algo);
+	run_specialized(sim, tracer, INT_MAX);
+
+	return take_results(sim);
+}
+
+Info* simulate_generic(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo)
+{
+	SimConfig config;
+	Simulation *sim;
+
+	init_sim_config(&config);
+	sim = start_simulation(processes, numOfProcesses, algo, &config);
+	print_title(outFile, algo);
+	run_loop(sim, tracer, INT_MAX, algo, tracer != NULL);									// One loop deciding the algorithm (and whether to trace) at every step
+
+	return take_results(sim);
 }
 
-void print_results(FILE *outFile, Process *processes, int numOfProcesses, Info **summaries, Algorithm algo)
+void print_results(FILE *outFile, Info **summaries, Algorithm algo)
 {
 	fprintf(outFile, "\n***************************************************\n");						// Print out title for summary after each algorithm simulation
 
@@ -649,32 +2086,45 @@ void print_results(FILE *outFile, Process *processes, int numOfProcesses, Info *
 		case NPP:
 			fprintf(outFile, "Priority Summary (WT = Wait Time, TT = Turnaround Time)\n\n");
 			break;
+
+		case CFS:
+			fprintf(outFile, "CFS Summary (WT = Wait Time, TT = Turnaround Time)\n\n");
+			break;
 	}
 
 	fprintf(outFile, "PID\tWT\tTT\n");																					// Table Header
 
-	for(int i = 0; i < numOfProcesses; i++)
-		fprintf(outFile, "%d\t%d\t%d\n", i, processes[i].waitTime, processes[i].turnaroundTime);						// Table Contents -- process number, wait time, and turnaround time
+	for(int i = 0; i < summaries[algo]->numOfProcesses; i++)
+		fprintf(outFile, "%d\t%d\t%d\n", i, summaries[algo]->waitTimes[i], summaries[algo]->turnaroundTimes[i]);						// Table Contents -- process number, wait time, and turnaround time
 
 	fprintf(outFile, "AVG\t%4.2f\t%4.2f\n\n", summaries[algo]->avgWaitTime, summaries[algo]->avgTurnaroundTime);		// Averages -- average wait time, average turnaround time
 
 	fprintf(outFile, "Process Sequence: ");																				// Process Sequence - the sequence in which the processes were executed
-	print_linked_list(outFile, summaries[algo]->processSequence);
+	print_timeline(outFile, summaries[algo]->processSequence);
+
+	fprintf(outFile, "Context Switches: %d\n", summaries[algo]->contextSwitches);										// Number of context switches in algorithm
+
+	if(summaries[algo]->numOfCpus > 1)																					// Processes only move between CPUs when there is more than one
+		fprintf(outFile, "Migrations: %d (%d CPUs)\n", summaries[algo]->migrations, summaries[algo]->numOfCpus);
 
-	fprintf(outFile, "Context Switches: %d\n\n\n", summaries[algo]->contextSwitches);									// Number of context switches in algorithm
+	if(algo == CFS)																										// Fairness - how far apart the virtual runtimes got, in ticks of a priority 0 process
+		fprintf(outFile, "Vruntime Spread: avg %.2f, max %.2f\n", (double) summaries[algo]->vruntimeSpreadSum / MAX(summaries[algo]->vruntimeSamples, 1) / CFS_TICK_VRUNTIME,
+				(double) summaries[algo]->vruntimeSpreadMax / CFS_TICK_VRUNTIME);
+
+	fprintf(outFile, "\n\n");
 }
 
 
 void print_overall_results(FILE *outFile, Info **summaries)
 {
-	int wt[5] = { 0, 1, 2, 3, 4 };
-	int tt[5] = { 0, 1, 2, 3, 4 };
-	int cs[5] = { 0, 1, 2, 3, 4 };
+	int wt[6] = { 0, 1, 2, 3, 4, 5 };
+	int tt[6] = { 0, 1, 2, 3, 4, 5 };
+	int cs[6] = { 0, 1, 2, 3, 4, 5 };
 	int temp;
 
-	for(int i = 0; i < 4; i++)																		// Simple bubble sort to sort wait times, turnaround times, and number of contexts switches in ascending order
+	for(int i = 0; i < 5; i++)																		// Simple bubble sort to sort wait times, turnaround times, and number of contexts switches in ascending order
 	{
-		for(int j = 0; j < 4 - i; j++)
+		for(int j = 0; j < 5 - i; j++)
 		{
 			if(summaries[wt[j]]->avgWaitTime > summaries[wt[j + 1]]->avgWaitTime)
 			{
@@ -701,7 +2151,7 @@ void print_overall_results(FILE *outFile, Info **summaries)
 
 	fprintf(outFile, "Wait Time Comparison\n");														// Wait times from lowest to highest
 
-	for(int i = 0; i < 5; i++)
+	for(int i = 0; i < 6; i++)
 	{
 		switch(wt[i])
 		{
@@ -719,12 +2169,15 @@ void print_overall_results(FILE *outFile, Info **summaries)
 				break;
 			case NPP:
 				fprintf(outFile, "Priority\t%4.2f\n", summaries[4]->avgWaitTime);
+				break;
+			case CFS:
+				fprintf(outFile, "CFS\t\t%4.2f\n", summaries[5]->avgWaitTime);
 		}
 	}
 
 	fprintf(outFile, "\nTurnaround Time Comparison\n");												// Turnaround times from lowest to highest
 
-	for(int i = 0; i < 5; i++)
+	for(int i = 0; i < 6; i++)
 	{
 		switch(tt[i])
 		{
@@ -743,13 +2196,16 @@ void print_overall_results(FILE *outFile, Info **summaries)
 			case NPP:
 				fprintf(outFile, "Priority\t%4.2f\n", summaries[4]->avgTurnaroundTime);
 				break;
+			case CFS:
+				fprintf(outFile, "CFS\t\t%4.2f\n", summaries[5]->avgTurnaroundTime);
+				break;
 		}
 	}
 	
 
 	fprintf(outFile, "\nContext Switch Comparison\n");												// Number of context switches from lowest to highest
 
-	for(int i = 0; i < 5; i++)
+	for(int i = 0; i < 6; i++)
 	{
 		switch(cs[i])
 		{
@@ -768,6 +2224,9 @@ void print_overall_results(FILE *outFile, Info **summaries)
 			case NPP:
 				fprintf(outFile, "Priority\t%d\n", summaries[4]->contextSwitches);
 				break;
+			case CFS:
+				fprintf(outFile, "CFS\t\t%d\n", summaries[5]->contextSwitches);
+				break;
 		}
 	}
 }
\ No newline at end of file
@@ -21,110 +21,853 @@ File History:
 #include <stdbool.h>
 #include <ctype.h>
 #include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <time.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <poll.h>
+
+#define READ_BUFFER_SIZE (1 << 20)
+#define STREAM_BUFFER_SIZE (1 << 16)		// Streaming reads its input a piece of this size at a time, whatever the size of the input
+#define TRACE_TEXT_SIZE (1 << 20)			// Trace text is written out in blocks of about this size
+#define TRACE_RING_SIZE (1 << 16)			// Number of records the asynchronous trace writer can fall behind by
+#define TRACE_FORMAT_VERSION 1				// Binary trace format written by this version of the simulator
+#define TRACE_BATCH_SIZE 256				// Number of records handed to the trace writer at once
+#define CACHE_FORMAT_VERSION 2				// Cached results written by this version of the simulator; part of every cache key
+#define SERVER_BACKLOG 64					// Accepted connections that can wait for a free server worker
+
+#define HISTOGRAM_SUB_BITS 7				// Histograms keep values below 2^(HISTOGRAM_SUB_BITS + 1) exactly and larger ones to within 1/2^HISTOGRAM_SUB_BITS
+#define HISTOGRAM_SUB_BUCKETS (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_BUCKETS ((32 - HISTOGRAM_SUB_BITS) * HISTOGRAM_SUB_BUCKETS)	// Enough for any non-negative int
+
+#define AGING_PERIOD 25						// Ticks between priority increases of a waiting process under priority scheduling
+#define CFS_TARGET_LATENCY 24				// Ticks in which CFS tries to run every runnable process once, each for a share matching its weight
+#define CFS_MIN_GRANULARITY 3				// Fewest ticks CFS lets a process run before it can be preempted
+#define CFS_NICE_0_WEIGHT 1024				// Weight of a process of priority 0; every step of priority changes the weight by about 1.25 times
+#define CFS_TICK_VRUNTIME 1024				// Virtual runtime one tick adds to a process of priority 0; finer than a tick so heavy processes
+											// lose little to rounding
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+#ifdef __GNUC__
+#define ALWAYS_INLINE inline __attribute__((always_inline))	// Used to compile a separate simulation loop for every algorithm
+#else
+#define ALWAYS_INLINE inline
+#endif
+
+#ifdef SCHED_INSTRUMENT						// Instrumented builds (make instrument) count where simulate() spends its time; other builds compile the counting out
+#define INSTRUMENT(...) __VA_ARGS__
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define read_cycles() __rdtsc()
+#else
+#define read_cycles() ((unsigned long long) clock())	// Processor time where there is no cycle counter
+#endif
+#else
+#define INSTRUMENT(...)
+#endif
 
 extern const int QUANTUM;
 
 extern const int NUM_OF_ALGORITHMS;
 
-typedef enum algorithm { FCFS, SJF, STCF, RR, NPP } Algorithm;				// Enumerated type for different algorithm types
+typedef enum algorithm { FCFS, SJF, STCF, RR, NPP, CFS } Algorithm;				// Enumerated type for different algorithm types
 
 typedef enum state { NEW, READY, RUNNING, WAITING, TERMINATED } State;		// Enumerated type for different states of a process
 
-typedef struct process {					// Process structure type to store appropriate information for a process
-
+typedef struct process {					// Process structure type to store the input information for a process; never changed by a simulation,
+											// so one table of processes can be shared by any number of simulations
 	int ID;									// Process ID (PID)
 	int burstTime;							// CPU Burst Time
 	int priority;							// Priority Level (lower number denotes higher priority)
 	int arrivalTime;						// Arrival Time
-	int timeRemaining;						// Time Remaining (how much time is left in order to finish process)
-	int startTime;							// Start Time (for calcuating wait time)
-	int lastStart;							// Last Start Time (for calculating when to switch in Round Robin)
-	int endTime;							// End Time (for calculating turnaround time)
-	int turnaroundTime;						// Turnaround Time (how long it took for the process to finish after arrival)
-	int waitTime;							// Wait Time (how long the process had to wait)
-	State status;							// Process State (for tracking when to put into ready queue)
 
 } Process;
 
+typedef struct runstate {					// Run state structure type - the information a simulation changes for every process, one array per
+											// field so the fields used together every tick are packed together
+	int numOfProcesses;
+	int *timeRemaining;						// Time Remaining (how much time is left in order to finish process)
+	int *priority;							// Current Priority Level (aging lowers it during priority scheduling)
+	int *startTime;							// Start Time (for calcuating wait time)
+	int *lastStart;							// Last Start Time (for calculating when to switch in Round Robin)
+	int *endTime;							// End Time (for calculating turnaround time)
+	long long *vruntime;					// Virtual runtime the process had before it ran (CFS); ticks it has run are added by its weight
+	unsigned char *status;					// Process State (for tracking when to put into ready queue)
+
+} RunState;
+
+typedef struct nodepool {					// Node pool structure type - hands out fixed-size nodes carved from large chunks so the simulation
+											// loop does not call malloc/free for every node; everything is released at once when the pool is
+	size_t nodeSize;						// released
+	void *freeNodes;						// Returned nodes, chained through their first bytes
+	void *chunks;							// Allocated chunks, chained through their first bytes
+	char *unused;							// Not yet handed out part of the newest chunk
+	int unusedNodes;
+	int chunkNodes;							// Number of nodes in the next chunk; doubles with every chunk up to a limit
+	long long requests;						// Number of nodes handed out
+	long long allocations;					// Number of malloc calls made
+
+} NodePool;
+
 typedef struct node {						// Queue node structure type - using linked list structure to allow for flexibility in size
 											// Used for ready queue
-	Process *data;
+	int ID;
+	int key;								// Burst time, time remaining or priority the queue is sorted by
 	struct node *next;
 
 } Node;
 
+typedef enum queuetype { LIST_QUEUE, HEAP_QUEUE, TREE_QUEUE } QueueType;				// Enumerated type for different ready queue implementations
+
+extern const QueueType SORTED_QUEUE_TYPE;									// Implementation used for the SJF, STCF and NPP ready queues
+
+typedef struct heapentry {					// Heap entry structure type - used by heap queues to order processes without walking a list
+
+	int ID;
+	int key;								// Burst time, time remaining or priority at the time of insertion
+	long long order;						// Insertion number; among equal keys the most recent insertion comes first, as in the sorted lists
+
+} HeapEntry;
+
+typedef struct treenode {					// Tree node structure type - used by tree queues, red-black trees ordered by key and then by insertion,
+											// each node counting the nodes below it so the position of an insertion is known
+	int ID;
+	bool red;
+	long long key;							// Virtual runtime at the time of insertion
+	long long order;						// Insertion number; among equal keys the earliest insertion comes first
+	int size;								// Number of nodes in the subtree rooted here
+	struct treenode *left;
+	struct treenode *right;
+	struct treenode *parent;
+
+} TreeNode;
+
 typedef struct queue {						// Queue structure type - using linked list structure to allow for flexibility in size
 											// Used for ready queue
 	Node *head;
 	Node *tail;
+	NodePool nodePool;						// Nodes are taken from and returned to the queue's own pool
+
+	QueueType type;							// Heap queues keep the current head in "front" and everything behind it in a binary min-heap
+	HeapEntry front;
+	HeapEntry *heap;
+	int heapSize;
+	int heapCapacity;
+	long long nextOrder;
+	HeapEntry *printBuffer;					// Scratch space for printing a heap queue in order
+	int printCapacity;
+	long long heapAllocations;				// Number of malloc/realloc calls made for the heap arrays
+	TreeNode *root;							// Tree queues keep every process in a red-black tree, with the head as its leftmost node
+	TreeNode *leftmost;
+	long long minVruntime;					// Least virtual runtime on the CPU the queue feeds, never decreasing (CFS)
+	long long totalWeight;					// Weights of the processes on the CPU the queue feeds, waiting or running (CFS)
+	int length;								// Number of processes in the queue
+#ifdef SCHED_INSTRUMENT
+	long long sortedEnqueues;
+	long long enqueueSteps;					// Nodes walked past, or heap levels sifted up through, finding the spots of sorted enqueues
+	int longestEnqueue;
+	int maxLength;
+#endif
 
 } Queue;
 
-typedef struct llnode {						// Linked list node structure type - allows for flexibility in size without having to reallocate memory everytime
-											// something has to be added
-	int data;								// Used for tracking sequence of processes
-	struct llnode *next;
+typedef struct interval {					// Interval structure type - one stretch of time a process held the CPU
+
+	int ID;
+	int cpu;								// CPU it ran on
+	int start;								// First tick the process ran
+	int end;								// Tick it gave up the CPU; -1 while it still holds it
+
+} Interval;
+
+typedef struct timeline {					// Timeline structure type - every time a process was loaded onto the CPU, in order, kept in one
+											// growable array
+	Interval *intervals;					// Used for tracking sequence of processes
+	int length;
+	int capacity;
+	long long allocations;					// Number of malloc/realloc calls made for the array
+
+} Timeline;
+
+typedef struct admissionindex {			// Admission index structure type - decides which processes enter the ready queue without scanning every process
+
+	int *arrivalOrder;						// Process IDs sorted by arrival time, ties by ID
+	int cursor;								// Position of the next process to arrive in arrivalOrder
+	int numOfProcesses;
+	int *waiting;							// IDs of preempted (waiting) processes, kept in ascending order
+	int numWaiting;
+	int waitingCapacity;
+	int nextArrived;						// Merge positions while handing out the processes entering the ready queue
+	int nextWaiting;
+
+} AdmissionIndex;
+
+typedef struct parsestate {				// Parse state structure type - lets the input be parsed in pieces without re-reading anything
+
+	Process *processes;						// Processes read so far; grown as needed
+	int numOfProcesses;
+	int capacity;
+	int field;								// Which field of the current process is read next
+	int value;								// Value of the number currently being read
+	bool inNumber;
+	bool inDigits;							// Whether the number read so far is all digits
+	long long bytes;						// Number of bytes parsed
+	int firstID;							// ID of processes[0]; advanced when a stream takes the processes read so far
+
+} ParseState;
+
+typedef struct parsestats {					// Parse statistics structure type
+
+	long long bytes;
+	double seconds;
+
+} ParseStats;
+
+typedef enum distributiontype { UNIFORM_DIST, EXPONENTIAL_DIST, PARETO_DIST, BURSTY_DIST } DistributionType;	// Enumerated type for generated value distributions
+
+typedef struct distribution {				// Distribution structure type - how one field of a generated workload is drawn
+
+	DistributionType type;
+	double mean;							// Average value drawn (before values are capped)
+	int min;								// Smallest value drawn; Pareto and bursty values sit at min most of the time
+	int max;								// Values above max are capped
+
+} Distribution;
+
+typedef struct workloadspec {				// Workload spec structure type - everything that decides a generated workload; The same spec
+											// always generates the same processes
+	int numOfProcesses;
+	unsigned long long seed;
+	Distribution burstTime;
+	Distribution priority;
+	Distribution arrivalGap;				// Time between one process arriving and the next; Arrivals are in ID order
+
+} WorkloadSpec;
+
+typedef struct workloadgenerator {			// Workload generator structure type - produces the processes of a spec one at a time
+
+	WorkloadSpec spec;
+	unsigned long long random;				// Random number generator state
+	int nextID;
+	long long arrivalTime;					// Arrival time of the last process generated
+
+} WorkloadGenerator;
+
+typedef enum recordtype { LOAD_RECORD, IDLE_RECORD, FINISH_LOAD_RECORD, FINISH_RECORD, PREEMPT_RECORD, RUN_RECORD,	// Enumerated type for trace records;
+						   ENQUEUE_RECORD, SORTED_ENQUEUE_RECORD, DEQUEUE_RECORD,											// what the CPU did, a ready queue change,
+						   BEGIN_RECORD, INSERT_RECORD } RecordType;															// or the start of an algorithm in a binary trace;
+																																// insert records give a ready queue position
+
+typedef struct tracerecord {				// Trace record structure type - compact description of a traced tick (or span of ticks) or of a
+											// ready queue change, formatted into text later
+	int type;
+	int time;								// First tick
+	int endTime;							// Tick after the last one; running and idle ticks that are skipped over form one span
+	int process;							// Running, finishing or preempted process (or the process entering the ready queue)
+	int value;								// Its remaining burst (or its ready queue key, or position for insert records)
+	int nextProcess;						// Process being loaded
+	int nextValue;							// Its burst
+
+} TraceRecord;
+
+typedef void (*TraceCallback)(void *context, const TraceRecord *record);										// Hands every trace record to a program using the simulator as a library
+
+typedef struct tracesampling {				// Trace sampling structure type - which spans a tracer keeps, for a lighter trace of a large run;
+											// ready queue changes are always kept
+	bool off;								// No trace at all; the simulation runs the loop with no tracing in it
+	int every;								// Keep every Nth span of what the CPU did
+	bool changesOnly;						// Keep only loads, finishes and preemptions, not running or idling
+	int fromTime;							// Keep only spans with a tick from fromTime through toTime
+	int toTime;
+
+} TraceSampling;
+
+typedef struct tracer {						// Tracer structure type - prints the interval trace of a simulation, either directly or through
+											// a ring of records formatted by a background writer thread
+	FILE *outFile;
+	int interval;
+	int fromTime;							// Only ticks from fromTime through toTime are printed
+	int toTime;
+	int sampleEvery;						// Only every Nth span is kept
+	long long sampleCount;
+	bool changesOnly;						// Running and idle spans are dropped
+	bool async;
+	bool binary;							// Binary tracers encode every record instead of printing the intervals
+	int lastTime;							// Time of the last record encoded; binary records store the difference
+	TraceCallback callback;					// Callback tracers hand every record to the callback instead of printing it
+	void *callbackContext;
+	char *text;								// Formatted text (or encoded records) waiting to be written out
+	size_t textLength;
+	size_t textCapacity;
+	int *ids;								// Scratch space for the ready queue contents
+	int idsCapacity;
+	long long bytesWritten;
+#ifdef SCHED_INSTRUMENT
+	unsigned long long cycles;				// Cycles spent in the trace functions called by the simulation
+	unsigned long long queueCycles;			// Cycles spent printing the ready queue, on whichever thread formats the text
+#endif
+
+	TraceRecord *ring;						// Asynchronous tracers only; positions only ever increase and wrap around the ring
+	unsigned long long ringHead;			// Next record written by the simulation
+	unsigned long long ringPublished;		// Records up to here are visible to the writer
+	unsigned long long ringTail;			// Records up to here are formatted by the writer
+	unsigned long long ringTailSeen;		// Simulation's last look at ringTail
+	bool finished;
+	Queue *replica;							// Writer's copy of the ready queue, kept up to date from the queue change records
+	pthread_t writer;
+	pthread_mutex_t lock;
+	pthread_cond_t notEmpty;
+	pthread_cond_t notFull;
+
+} Tracer;
+
+typedef struct tracereader {				// Trace reader structure type - reads a binary trace a large block at a time
+
+	FILE *inFile;
+	unsigned char *data;
+	size_t length;
+	size_t position;
+
+} TraceReader;
+
+typedef struct cpu {						// CPU structure type - one CPU of a multi-CPU simulation
+
+	Queue *readyQueue;						// Processes waiting for this CPU
+	int activeProcess;
+	int lastTick;							// Ticks before this one are accounted for; the running process ran through every one of them
+	int eventTime;							// Next tick something can change on the CPU by itself; INT_MAX when nothing can
+	int interval;							// Timeline interval of the running process
+	int slots[3];							// Position in each CPU heap
+
+} Cpu;
+
+typedef enum cpuheaptype { EVENT_HEAP, LOAD_HEAP, QUEUE_HEAP } CpuHeapType;	// Enumerated type for how a CPU heap orders the CPUs
+
+typedef struct cpuheap {					// CPU heap structure type - every CPU ordered by the next event, by the least work, or by the
+											// longest ready queue, so no decision looks at every CPU
+	CpuHeapType type;
+	Cpu *cpus;
+	int *order;								// CPU indexes in heap order
+	int size;
+
+} CpuHeap;
+
+typedef struct histogram {					// Histogram structure type - counts values in log-linear buckets (HDR-style), so percentiles of
+											// any number of values take the same, fixed amount of memory
+	long long counts[HISTOGRAM_BUCKETS];
+	long long count;						// Number of values recorded
+	double sum;
+	int max;
+
+} Histogram;
+
+typedef struct latencystats {				// Latency stats structure type - the times of finished processes, recorded as they finish
+											// rather than from a pass over every process at the end
+	Histogram wait;
+	Histogram turnaround;
+	Histogram response;						// First start time - arrival time, recorded when a process first runs
+
+} LatencyStats;
+
+typedef struct simconfig {					// Simulation config structure type - settings of a simulation that may change between runs
+
+	int quantum;							// Round robin quantum
+	int agingPeriod;						// Priority scheduling aging period
+	int numOfCpus;							// More than one simulates a multi-CPU system with a ready queue per CPU
+
+} SimConfig;
+
+typedef struct streamslot {					// Stream slot structure type - one live process of a streaming simulation; the slot is reused once
+											// the process finishes
+	int ID;
+	int arrivalTime;
+	int burstTime;
+	int priority;
+	int timeRemaining;
+	int lastStart;
+	long long vruntime;						// Virtual runtime the process had before it ran (CFS)
+
+} StreamSlot;
+
+typedef struct streamsim {					// Stream simulation structure type - one algorithm simulated as the input is read, keeping only
+											// the processes that have been read but not finished
+	Algorithm algo;
+	SimConfig config;
+	Queue *readyQueue;						// Holds slot numbers rather than process IDs
+	StreamSlot *slots;
+	int capacity;
+	int *freeSlots;							// Slots of finished processes, ready to be reused
+	int numFree;
+	int numLive;
+	int peakLive;
+	int *arrivals;							// Slots of processes read but not yet arrived, in arrival order
+	int firstArrival;
+	int numArrivals;
+	int activeSlot;
+	int waitingSlot;						// Slot preempted on the previous tick; it goes back into the ready queue on this one
+	int currentTime;						// Every tick before this one has been simulated
+	int lastTick;							// Ticks before this one are accounted for; the running process ran through every one of them
+	int eventTime;							// Next tick the CPU can change by itself; INT_MAX when it cannot
+	int endTime;							// Time at which the last process finished
+	long long numDone;
+	long long contextSwitches;
+	LatencyStats latency;
+
+} StreamSim;
+
+typedef struct stream {						// Stream structure type - every algorithm simulated side by side over one pass of the input,
+											// reporting running averages every report period
+	FILE *outFile;
+	StreamSim *sims;						// One for every algorithm
+	int reportPeriod;						// Ticks between reports; 0 reports only at the end
+	int nextReport;
+	int lastArrival;
+	long long numOfProcesses;
+
+} Stream;
+
+typedef struct simoptions {					// Simulation options structure type - everything a program using the simulator as a library chooses
+											// about one simulation
+	Algorithm algo;
+	int quantum;							// Round robin quantum
+	int agingPeriod;						// Priority scheduling aging period
+	int numOfCpus;
+	TraceCallback trace;					// Called with every trace record, or NULL for no trace; single CPU only
+	void *traceContext;						// Passed to trace as is
+
+} SimOptions;
+
+typedef struct latencysummary {				// Latency summary structure type - one of the latency histograms, reduced to a few numbers
+
+	double mean;
+	int p50;
+	int p90;
+	int p99;
+	int max;
+
+} LatencySummary;
+
+typedef struct simresults {					// Simulation results structure type - the results of one simulation run through a context
+
+	double avgWaitTime;
+	double avgTurnaroundTime;
+	int contextSwitches;
+	int migrations;
+	int endTime;							// Time at which the last process finished
+	int numOfProcesses;
+	LatencySummary wait;
+	LatencySummary turnaround;
+	LatencySummary response;
+	const int *waitTimes;					// Wait and turnaround time of every process; owned by the context and valid until its next run
+	const int *turnaroundTimes;
+
+} SimResults;
+
+typedef struct simcontext SimContext;		// Simulation context structure type - opaque; what one thread needs to run simulations one after
+											// another, so nothing is shared between threads with their own contexts
+
+typedef void (*JobFunction)(void *context, int job);															// Runs job number job of a parallel run
+
+typedef struct workrange {					// Work range structure type - the jobs one thread of a pool has left, first up to (not including) last
+
+	int first;								// Taken by the thread that owns the range
+	int last;								// Other threads steal from this end once they run out
+	pthread_mutex_t lock;
+
+} WorkRange;
+
+typedef struct threadpool {					// Thread pool structure type - runs numbered jobs over a fixed set of threads; Every thread starts
+											// with an even share of the jobs and steals half of another thread's remaining jobs when it runs out
+	JobFunction run;
+	void *context;							// Shared by every job
+	int numOfThreads;
+	WorkRange *ranges;						// One for every thread
+
+} ThreadPool;
+
+typedef struct poolthread {					// Pool thread structure type - one thread of a thread pool
+
+	ThreadPool *pool;
+	int index;								// Which range the thread owns
+	pthread_t thread;
+
+} PoolThread;
+
+typedef struct batchfile {					// Batch file structure type - one input file of a batch; Its algorithms are separate jobs, and
+											// whichever finishes last writes the file's output
+	char *inputName;
+	char *outputName;
+	Process *processes;						// Loaded by the first of its jobs to run, freed by the last
+	int numOfProcesses;
+	bool loaded;
+	bool failed;							// Input could not be read
+	int jobsLeft;
+	struct info **summaries;				// One for every algorithm, freed once the output is written
+	char **outputs;							// Everything printed for every algorithm
+	size_t *outputSizes;
+	double *avgWaitTimes;					// Results kept for the batch summary
+	double *avgTurnaroundTimes;
+	int *contextSwitches;
+	pthread_mutex_t lock;
+
+} BatchFile;
 
-} LLNode;
+typedef struct batch {						// Batch structure type - every input file of a batch
 
-typedef struct linkedlist {					// Linked list node structure type - allows for flexibility in size without having to reallocate memory everytime
-											// something has to be added
-	LLNode *head;							// Used for tracking sequence of processes
-	LLNode *tail;
+	BatchFile *files;
+	int numOfFiles;
+	int interval;
 
-} LinkedList;
+} Batch;
+
+#ifdef SCHED_INSTRUMENT
+typedef enum instrumentphase { ADMIT_PHASE, DISPATCH_PHASE, ADVANCE_PHASE, TRACE_PHASE, NUM_OF_PHASES } InstrumentPhase;	// Admitting arrivals, loading/finishing/preempting, jumping to the next event, tracing
+
+typedef struct phaseclock {					// Phase clock structure type - start of the phase being timed
+
+	unsigned long long start;
+	unsigned long long traceStart;			// Trace cycles at the start, so tracing is not counted in the phase that traced
+
+} PhaseClock;
+
+typedef struct instrumentation {			// Instrumentation structure type - where a simulation spent its time
+
+	unsigned long long cycles[NUM_OF_PHASES];
+	unsigned long long queueCycles;			// Part of the trace phase spent printing the ready queue
+	long long events;						// Times round the simulation loop
+	long long sortedEnqueues;
+	long long enqueueSteps;
+	int longestEnqueue;
+	int maxQueueDepth;
+	long long traceBytes;					// Trace bytes written or waiting to be; -1 when a background thread is still writing
+
+} Instrumentation;
+#endif
 
 typedef struct info {						// Algorithm summary info structure type
 	
 	double avgWaitTime;
 	double avgTurnaroundTime;
-	LinkedList *processSequence;
+	Timeline *processSequence;
 	int contextSwitches;
+	int migrations;							// Number of times a process was moved to another CPU's ready queue
+	int numOfCpus;
+	int endTime;							// Time at which the last process finished
+	int numOfProcesses;
+	int *waitTimes;							// Wait and turnaround time of every process
+	int *turnaroundTimes;
+	LatencyStats latency;
+	long long nodeRequests;					// Number of ready queue nodes used during the simulation
+	long long allocations;					// Number of malloc/realloc calls made by the ready queue and process sequence
+	long long vruntimeSpreadMax;			// Largest gap between the least and greatest virtual runtime of the runnable processes (CFS),
+	long long vruntimeSpreadSum;			// sampled whenever a process is loaded
+	long long vruntimeSamples;
+#ifdef SCHED_INSTRUMENT
+	Instrumentation instrumentation;
+#endif
 
 } Info;
 
+typedef struct cacheheader {				// Cache header structure type - start of a cached result file, followed by the wait times,
+											// turnaround times, latency histograms and process sequence
+	int version;
+	unsigned long long key;					// Checked against the key the file was looked up by
+	int numOfProcesses;
+	int sequenceLength;
+	double avgWaitTime;
+	double avgTurnaroundTime;
+	int contextSwitches;
+	int migrations;
+	int numOfCpus;
+	int endTime;
+	long long nodeRequests;
+	long long vruntimeSpreadMax;
+	long long vruntimeSpreadSum;
+	long long vruntimeSamples;
+	long long allocations;
+
+} CacheHeader;
+
+typedef struct serverrequest {				// Server request structure type - the settings read from the first line of a request
+
+	SimOptions options;
+	bool allAlgorithms;						// Whether every algorithm is simulated, rather than only options.algo
+	int numOfProcesses;						// Processes sent after the request line; 0 when they are generated
+	bool generated;							// Whether the processes are generated from workload instead
+	WorkloadSpec workload;
+
+} ServerRequest;
+
+typedef struct server {						// Server structure type - connections accepted and waiting for a worker, and what every worker
+											// is serving; Each worker keeps its own simulation context between requests
+	int listenFd;
+	int numOfThreads;
+	int pending[SERVER_BACKLOG];			// Ring of accepted connections, oldest first
+	int firstPending;
+	int numOfPending;
+	int *active;							// Connection each worker is serving, or -1; shut down to stop the server
+	bool stopping;
+	bool verbose;
+	long long requests;						// Requests served by every worker so far
+	pthread_mutex_t lock;
+	pthread_cond_t notEmpty;
+	int wakeFds[2];							// Pipe waking the accepting thread; written by the interrupt handler and by workers making room
+
+} Server;
+
+typedef struct serverworker {				// Server worker structure type - one thread of a server
+
+	Server *server;
+	int index;								// Which entry of active the worker updates
+	pthread_t thread;
+
+} ServerWorker;
+
+typedef struct simulation {					// Simulation structure type - everything a single CPU simulation has done up to currentTime, so it
+											// can be stopped there, snapshot, and resumed or forked with a changed workload
+	const Process *processes;
+	Process *ownProcesses;					// Forks keep their own changed copy of the processes; NULL otherwise
+	int numOfProcesses;
+	Algorithm algo;
+	SimConfig config;
+	int currentTime;						// Next tick to simulate; nothing at this tick has happened yet
+	int processesComplete;
+	int activeProcess;
+	Info *summary;							// Results so far; the averages are still sums
+	RunState *state;
+	Queue *readyQueue;
+	AdmissionIndex *admission;
+
+} Simulation;
+
+void init_node_pool(NodePool *pool, size_t nodeSize);															// Initialize node pool for nodes of the given size
+
+void* pool_alloc(NodePool *pool);																				// Hands out a node, reusing a returned one when possible
+
+void pool_free(NodePool *pool, void *node);																		// Returns a node to the pool for reuse
+
+void release_node_pool(NodePool *pool);																			// Deallocates every chunk of the pool at once
+
 Queue* make_queue();																							// Initialize queue data structure
 
-void enqueue_process(Queue *queue, Process *process);															// Add process to queue, new process is new tail for FIFO operation
+Queue* make_heap_queue();																						// Initialize heap-based queue data structure; Used with the sorted enqueue functions
+
+Queue* make_tree_queue();																						// Initialize tree-based queue data structure; Used with tree_enqueue_process for CFS
 
-void burst_time_enqueue_process(Queue *queue, Process *process);												// Add process to queue, burst time acts as priority; Used for SJF
+void enqueue_process(Queue *queue, int ID);																		// Add process to queue, new process is new tail for FIFO operation
 
-void time_remaining_enqueue_process(Queue *queue, Process *process);											// Add process to queue, time remaining acts as priority: Used for STCF
+void sorted_enqueue_process(Queue *queue, int ID, int key);														// Add process to queue ordered by key (burst time for SJF, time remaining for STCF, priority for NPP)
 
-void priority_enqueue_process(Queue *queue, Process *process);													// Add process to priority queue
+int tree_enqueue_process(Queue *queue, int ID, long long key);													// Add process to tree queue ordered by key (virtual runtime), after any equal keys; Returns its position
+
+void insert_process(Queue *queue, int ID, int position);														// Add process to list queue at the given position, as a tree queue it replicates did
 
 int dequeue_process(Queue *queue);																				// Returns first process's ID from queue and removes it
 
 int peek_queue(Queue *queue);																					// Returns first process's ID without removing it from the queue
 
+int queue_contents(Queue *queue, int *ids);																		// Copies the processes' IDs in queue order into ids (which must hold the queue length); Returns the length
+
 bool is_queue_empty(Queue *queue);																				// Returns whether or not the queue is currently empty
 
 void print_queue(FILE *outFile, Queue *queue);																	// Prints the contents of the queue (just the processes' IDs)
 
+Queue* copy_queue(Queue *queue);																				// Copies queue, contents and order included
+
 void destroy_queue(Queue *queue);																				// Destroys/deallocates queue to avoid memory leaks
 
-LinkedList* make_linked_list();																					// Initialize linked list data structure
+Timeline* make_timeline();																						// Initialize timeline data structure
+
+void add_to_timeline(Timeline *timeline, int ID, int startTime);												// Adds the process loaded at startTime to the end of the timeline, ending the interval before it
 
-void add_to_linked_list(LinkedList *ll, int data);																// Adds data to linked list, emulating a queue for FIFO operation
+void end_timeline(Timeline *timeline, int endTime);																// Ends the last interval of the timeline at endTime if it is still running
 
-void print_linked_list(FILE *outFile, LinkedList *ll);															// Prints the contents of the linked list
+int add_cpu_to_timeline(Timeline *timeline, int ID, int cpu, int startTime);									// Adds the process loaded onto the CPU at startTime without ending any other interval; Returns the new interval's index
 
-bool is_linked_list_empty(LinkedList *ll);																		// Returns whether or not the linked list is currently empty
+void print_timeline(FILE *outFile, Timeline *timeline);															// Prints the sequence of processes in the timeline (just the processes' IDs)
 
-void destroy_linked_list(LinkedList *ll);																		// Destroys/deallocates linked list to avoid memory leaks		
+void print_gantt_chart(FILE *outFile, Timeline *timeline);														// Prints every interval of the timeline with the ticks the process held the CPU
 
-Info* make_info();																								// Initialize info data structure	
+Timeline* copy_timeline(Timeline *timeline);																	// Copies timeline
+
+void destroy_timeline(Timeline *timeline);																		// Destroys/deallocates timeline to avoid memory leaks
+
+AdmissionIndex* make_admission_index(const Process *processes, int numOfProcesses);								// Initialize admission index by sorting the processes by arrival time
+
+void add_waiting_process(AdmissionIndex *index, int ID);														// Remember a preempted process so it is put back into the ready queue
+
+int next_arrival_time(AdmissionIndex *index, const Process *processes);											// Returns the arrival time of the next process to arrive, or INT_MAX if none are left
+
+void begin_admissions(AdmissionIndex *index, const Process *processes, int currentTime);						// Finds the processes entering the ready queue at the current time
+
+int next_admission(AdmissionIndex *index);																		// Returns the next (in ID order) process entering the ready queue, or -1 when there are no more
+
+AdmissionIndex* copy_admission_index(AdmissionIndex *index);													// Copies admission index, waiting processes included
+
+void destroy_admission_index(AdmissionIndex *index);															// Destroys/deallocates admission index to avoid memory leaks
+
+Info* make_info(int numOfProcesses);																			// Initialize info data structure	
+
+Info* copy_info(Info *information);																				// Copies info, latency histograms included
 
 void destroy_info(Info* information);																			// Destroys/deallocates info structure type to avoid memory leaks
 
-int find_num_of_processes(FILE *inFile);																		// Read input file for number of processes to simulate
+void init_histogram(Histogram *histogram);																		// Initialize histogram with no values
+
+void record_value(Histogram *histogram, int value);																// Adds a value (negative values count as 0) to the histogram
+
+int histogram_percentile(const Histogram *histogram, double percentile);										// Returns the smallest value at least percentile percent of the values are at or below, to the histogram's precision
+
+void init_latency_stats(LatencyStats *stats);																	// Initialize latency stats with no processes
+
+void record_finished_process(Info *summary, int ID, int turnaroundTime, int burstTime);							// Records the wait and turnaround times of a process as it terminates
+
+void print_latency_stats(FILE *outFile, const LatencyStats *stats);												// Prints the mean, percentiles and maximum of the wait, turnaround and response times
 
-Process* load_processes(FILE *inFile, int numOfProcesses);														// Read input file and load contents into process objects
+#ifdef SCHED_INSTRUMENT
+void print_instrumentation(FILE *outFile, const Info *summary, Algorithm algo);									// Prints the phase cycle counts and other counters of an instrumented build
+#endif
 
-Info* simulate(FILE *outFile, int interval, Process *processes, int numOfProcesses, Algorithm algo);			// Main simulation
+double elapsed_seconds(struct timespec *start);																	// Returns the seconds passed since the given monotonic clock reading
 
-void print_results(FILE *outFile, Process *processes, int numOfProcesses, Info **summaries, Algorithm algo);	// Print the end-of-algorithm statistics and results
+void parse_processes(ParseState *state, const char *data, size_t length);										// Parses the next piece of the input, adding every complete process to the state
+
+Process* load_processes(const char *fileName, int *numOfProcesses, ParseStats *stats);							// Read input file ("-" for standard input) and load contents into process objects
+
+void init_workload_spec(WorkloadSpec *spec, int numOfProcesses, unsigned long long seed);						// Initialize spec with the default distributions: bursts of 1-100, priorities of 0-9, arrivals keeping the CPU about busy
+
+bool parse_distribution(const char *text, Distribution *dist);													// Reads a distribution written as uniform:MIN:MAX, exp:MEAN[:MIN[:MAX]], pareto:MEAN[:MIN[:MAX]] or bursty:MEAN[:MIN[:MAX]]
+
+bool parse_workload_spec(const char *text, WorkloadSpec *spec);													// Reads a spec written as comma separated n=, seed=, burst=, priority= and arrival= settings; Unset settings keep their defaults
+
+void init_workload_generator(WorkloadGenerator *generator, const WorkloadSpec *spec);							// Initialize generator to produce the processes of the spec from the first
+
+bool next_generated_process(WorkloadGenerator *generator, Process *process);									// Generates the next process; Returns false once every process of the spec has been generated
+
+Process* generate_processes(const WorkloadSpec *spec, int *numOfProcesses);										// Generates every process of the spec in memory, ready to simulate
+
+long long write_workload(FILE *outFile, const WorkloadSpec *spec);												// Writes the processes of the spec in the input file format without keeping them in memory; Returns the bytes written
+
+const char* algorithm_name(Algorithm algo);																		// Returns the short name of the algorithm
+
+int cfs_weight(int priority);																					// Returns the CFS weight of a priority, read as a nice value (-20 through 19)
+
+long long cfs_vruntime(long long base, int ticksRun, int weight);												// Returns the virtual runtime of a process that started at base and has run ticksRun ticks
+
+long long cfs_place(Queue *queue, long long runningVruntime);													// Advances the queue's least virtual runtime past the running process (LLONG_MAX for none) and the head; Returns it, where new processes start
+
+int cfs_slice(const Queue *queue, int weight);																	// Returns the ticks a process of the weight may run before the head of the queue can take over
+
+bool cfs_preempts(const Queue *queue, long long vruntime, int weight, int ticksRan);							// Returns whether the head of the (non-empty) queue takes over from a process that has run ticksRan ticks since loaded
+
+int cfs_preempt_time(const Queue *queue, long long base, int ticksRun, int weight, int lastStart, int currentTime);	// Returns the first tick after currentTime at which cfs_preempts holds, if the process keeps running
+
+void record_vruntime_spread(Info *summary, const Queue *queue, long long vruntime);								// Samples the spread of virtual runtimes between the process just loaded and the queue
+
+RunState* make_run_state(const Process *processes, int numOfProcesses);											// Initialize run state data structure for a new simulation of the processes
+
+RunState* copy_run_state(RunState *state);																		// Copies run state
+
+void destroy_run_state(RunState *state);																		// Destroys/deallocates run state to avoid memory leaks
+
+Tracer* make_tracer(FILE *outFile, int interval, bool async);													// Initialize tracer printing every interval ticks; async formats and writes from a background thread
+
+Tracer* make_binary_tracer(FILE *traceFile, Algorithm algo);													// Initialize tracer encoding every event of the algorithm's simulation into a compact binary trace
+
+Tracer* make_callback_tracer(TraceCallback callback, void *context);											// Initialize tracer that calls callback with every record, in order, on the simulating thread
+
+void init_trace_sampling(TraceSampling *sampling);																// Initialize sampling that keeps the whole trace
+
+bool parse_trace_sampling(const char *text, TraceSampling *sampling);											// Parses a comma separated list of off, every=N, changes and window=FROM:TO; Returns false if it is invalid
+
+void sample_tracer(Tracer *tracer, const TraceSampling *sampling);												// Makes tracer keep only the spans the sampling selects
+
+void trace_enqueue(Tracer *tracer, int ID, int key, bool sorted);												// Tells the tracer a process entered the ready queue
+
+void trace_insert(Tracer *tracer, int ID, int position);														// Tells the tracer a process entered the ready queue at a position
+
+void trace_dequeue(Tracer *tracer);																				// Tells the tracer the head of the ready queue was removed
+
+void trace_span(Tracer *tracer, RecordType type, int fromTime, int toTime, int process, int value, int nextProcess, int nextValue, Queue *readyQueue);	// Traces what the CPU did in ticks fromTime up to (not including) toTime
+
+void destroy_tracer(Tracer *tracer);																			// Writes out everything left, then destroys/deallocates tracer to avoid memory leaks
+
+bool render_trace(FILE *traceFile, FILE *outFile, int interval, int fromTime, int toTime);						// Prints a binary trace as the usual interval trace, only ticks fromTime through toTime; Returns false if the trace is malformed
+
+int default_thread_count();																						// Returns the number of processors available to run threads on
+
+void run_parallel(int numOfJobs, int numOfThreads, JobFunction run, void *context);								// Runs jobs 0 through numOfJobs - 1 over numOfThreads threads, returning once every job is done
+
+int run_batch(const char *inputs, const char *outDirectory, int interval, int numOfThreads, bool verbose);		// Simulates every file of a directory or manifest, writing their outputs and a summary into outDirectory; Returns the number of unreadable files, or -1
+
+Stream* make_stream(FILE *outFile, int reportPeriod, const SimConfig *config);									// Initialize stream to simulate every algorithm as processes are added, reporting every reportPeriod ticks
+
+bool stream_process(Stream *stream, const Process *process);													// Adds the next process of the input; Returns false if it arrives before the one added last
+
+void finish_stream(Stream *stream);																				// Simulates until every process added has finished, then prints the summary
+
+void destroy_stream(Stream *stream);																			// Destroys/deallocates stream to avoid memory leaks
+
+long long stream_file(Stream *stream, const char *fileName);													// Streams every process of the input file ("-" for standard input), reading a piece at a time; Returns the number of processes, -1 if unreadable or -2 if out of arrival order
+
+SimContext* make_sim_context();																					// Initialize simulation context for a program using the simulator as a library
+
+void init_sim_options(SimOptions *options, Algorithm algo);														// Initialize options with the default settings for the algorithm
+
+int run_sim_context(SimContext *context, const Process *processes, int numOfProcesses, const SimOptions *options, SimResults *results);	// Simulates without printing anything, filling in results; Returns 0, or -1 if the options or processes are invalid
+
+void destroy_sim_context(SimContext *context);																	// Destroys/deallocates simulation context, and the results it owns, to avoid memory leaks
+
+void init_sim_config(SimConfig *config);																		// Initialize config with the default settings (QUANTUM and AGING_PERIOD)
+
+Info* simulate(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo);	// Main simulation; the processes themselves are left unchanged
+
+Info* simulate_config(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config);	// Same simulation with the given settings; outFile may be NULL to print nothing
+
+Info* simulate_smp(FILE *outFile, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config);	// Multi-CPU simulation with a ready queue per CPU; Idle CPUs steal from the longest ready queue
+
+Info* simulate_generic(FILE *outFile, Tracer *tracer, const Process *processes, int numOfProcesses, Algorithm algo);	// Same simulation from a single loop shared by every algorithm; Used for benchmarking
+
+Simulation* start_simulation(const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config);	// Same simulation, run a part at a time; NULL for more than one CPU; The processes must outlive it
+
+bool run_simulation(Simulation *sim, int stopTime);																// Simulates up to (not including) stopTime; Returns true once every process has finished
+
+Simulation* snapshot_simulation(const Simulation *sim);															// Copies simulation so both can carry on separately
+
+Simulation* fork_simulation(const Simulation *sim, const Process *processes);									// Copies simulation, continuing with the processes changed; NULL if a changed process has already arrived
+
+Info* finish_simulation(Simulation *sim);																		// Simulates the rest and returns the results; Destroys the simulation
+
+void destroy_simulation(Simulation *sim);																		// Destroys/deallocates simulation to avoid memory leaks
+
+void print_title(FILE *outFile, Algorithm algo);																// Print the title the simulation of the algorithm starts with; Nothing if outFile is NULL
+
+void print_results(FILE *outFile, Info **summaries, Algorithm algo);											// Print the end-of-algorithm statistics and results
 
 void print_overall_results(FILE *outFile, Info **summaries);													// Print the summary of performances for every algorithm
 
+unsigned long long hash_workload(const Process *processes, int numOfProcesses);									// Returns the FNV-1a hash of every process's fields
+
+unsigned long long cache_key(unsigned long long workloadHash, Algorithm algo, const SimConfig *config);			// Returns the key the results of simulating the hashed processes with algo and config are cached under
+
+Info* load_cached_info(const char *cacheDir, unsigned long long key, int numOfProcesses);						// Returns the results cached under key in cacheDir; NULL if there are none
+
+bool store_cached_info(const char *cacheDir, unsigned long long key, const Info *summary);						// Caches the results under key in cacheDir, creating it if needed; Returns false if they could not be written
+
+Info* simulate_cached(FILE *outFile, const char *cacheDir, unsigned long long workloadHash, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config, bool *hit);	// Untraced simulation whose results come from the cache when they are there, and go into it when not
+
+int serve_connection(FILE *inFile, FILE *outFile, SimContext *context);											// Answers every request read from inFile on outFile until inFile ends or a request is malformed; Returns the number of requests answered
+
+int run_server(const char *socketPath, int numOfThreads, bool verbose);											// Serves connections to a Unix domain socket at socketPath over numOfThreads workers until interrupted; Returns 0, or -1 if the socket cannot be made
+
 #endif
\ No newline at end of file
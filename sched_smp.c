@@ -0,0 +1,345 @@
+/*************************************************************************************
+File Name: sched_smp.c
+
+Objective: Simulate the CPU scheduling algorithms on a multi-CPU system, with a ready
+		   queue per CPU and idle CPUs stealing work from the busiest ready queue
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+static int cpu_load(Cpu *cpu)
+{
+	return cpu->readyQueue->length + (cpu->activeProcess != -1);
+}
+
+static bool cpu_before(CpuHeap *heap, int a, int b)
+{
+	Cpu *first = &heap->cpus[a], *second = &heap->cpus[b];
+
+	switch(heap->type)														// Ties go to the lower CPU, so runs are repeatable
+	{
+		case EVENT_HEAP:
+			if(first->eventTime != second->eventTime)
+				return first->eventTime < second->eventTime;
+			break;
+
+		case LOAD_HEAP:
+			if(cpu_load(first) != cpu_load(second))
+				return cpu_load(first) < cpu_load(second);
+			break;
+
+		case QUEUE_HEAP:
+			if(first->readyQueue->length != second->readyQueue->length)
+				return first->readyQueue->length > second->readyQueue->length;
+			break;
+	}
+
+	return a < b;
+}
+
+static void swap_cpus(CpuHeap *heap, int i, int j)
+{
+	int temp = heap->order[i];
+
+	heap->order[i] = heap->order[j];
+	heap->order[j] = temp;
+
+	heap->cpus[heap->order[i]].slots[heap->type] = i;
+	heap->cpus[heap->order[j]].slots[heap->type] = j;
+}
+
+static void fix_cpu_heap(CpuHeap *heap, int cpu)
+{
+	int i = heap->cpus[cpu].slots[heap->type];
+
+	while(i > 0 && cpu_before(heap, heap->order[i], heap->order[(i - 1) / 2]))	// Move up while it comes before its parent
+	{
+		swap_cpus(heap, i, (i - 1) / 2);
+		i = (i - 1) / 2;
+	}
+
+	while(true)																// Then down while a child comes before it
+	{
+		int best = i, left = 2 * i + 1, right = 2 * i + 2;
+
+		if(left < heap->size && cpu_before(heap, heap->order[left], heap->order[best]))
+			best = left;
+		if(right < heap->size && cpu_before(heap, heap->order[right], heap->order[best]))
+			best = right;
+
+		if(best == i)
+			break;
+
+		swap_cpus(heap, i, best);
+		i = best;
+	}
+}
+
+static void init_cpu_heap(CpuHeap *heap, CpuHeapType type, Cpu *cpus, int numOfCpus)
+{
+	heap->type = type;
+	heap->cpus = cpus;
+	heap->size = numOfCpus;
+	heap->order = (int *) malloc(sizeof(int) * numOfCpus);
+
+	for(int i = 0; i < numOfCpus; i++)										// Every CPU starts out the same, so CPU order is already heap order
+	{
+		heap->order[i] = i;
+		cpus[i].slots[type] = i;
+	}
+}
+
+static void fix_cpu(CpuHeap *heaps, int cpu)
+{
+	for(int type = EVENT_HEAP; type <= QUEUE_HEAP; type++)
+		fix_cpu_heap(&heaps[type], cpu);
+}
+
+static long long running_vruntime(const Cpu *cpu, const Process *processes, const RunState *state, int currentTime)
+{
+	int ID = cpu->activeProcess;
+
+	if(ID == -1)
+		return LLONG_MAX;
+
+	return cfs_vruntime(state->vruntime[ID], processes[ID].burstTime - state->timeRemaining[ID] + currentTime - cpu->lastTick,	// Counting the ticks not yet
+						cfs_weight(processes[ID].priority));																	// taken off its time remaining
+}
+
+static void enqueue_on_cpu(Cpu *cpu, const Process *processes, RunState *state, int ID, Algorithm algo, int currentTime)
+{
+	switch(algo)															// Same ready queue order as the single CPU simulation
+	{
+		case FCFS: case RR:
+			enqueue_process(cpu->readyQueue, ID);
+			break;
+
+		case SJF:
+			sorted_enqueue_process(cpu->readyQueue, ID, processes[ID].burstTime);
+			break;
+
+		case STCF:
+			sorted_enqueue_process(cpu->readyQueue, ID, state->timeRemaining[ID]);
+			break;
+
+		case NPP:
+			sorted_enqueue_process(cpu->readyQueue, ID, state->priority[ID]);
+			break;
+
+		case CFS:
+			if(state->status[ID] == NEW)									// Placed against this CPU's least virtual runtime
+			{
+				state->vruntime[ID] = cfs_place(cpu->readyQueue, running_vruntime(cpu, processes, state, currentTime));
+				cpu->readyQueue->totalWeight += cfs_weight(processes[ID].priority);
+			}
+
+			tree_enqueue_process(cpu->readyQueue, ID, cfs_vruntime(state->vruntime[ID], processes[ID].burstTime - state->timeRemaining[ID], cfs_weight(processes[ID].priority)));
+			break;
+	}
+
+	state->status[ID] = READY;
+}
+
+static void load_process(Cpu *cpu, int index, const Process *processes, RunState *state, Info *summary, int *cpuOf, int currentTime)
+{
+	int ID = dequeue_process(cpu->readyQueue);
+
+	cpu->activeProcess = ID;
+	state->status[ID] = RUNNING;
+
+	if(state->timeRemaining[ID] == processes[ID].burstTime)
+	{
+		state->startTime[ID] = currentTime;									// Set start time for new process, not for a preempted one
+		record_value(&summary->latency.response, currentTime - processes[ID].arrivalTime);
+	}
+
+	state->lastStart[ID] = currentTime;
+	state->timeRemaining[ID]--;												// Runs for the current tick
+	summary->contextSwitches++;
+
+	if(cpu->readyQueue->type == TREE_QUEUE)									// Fairness is sampled as on a single CPU, one ready queue at a time
+		record_vruntime_spread(summary, cpu->readyQueue, cfs_vruntime(state->vruntime[ID], processes[ID].burstTime - state->timeRemaining[ID], cfs_weight(processes[ID].priority)));
+
+	cpuOf[ID] = index;														// Preempted processes go back to the CPU they ran on
+	cpu->interval = add_cpu_to_timeline(summary->processSequence, ID, index, currentTime);
+}
+
+static void stop_process(Cpu *cpu, Info *summary, int currentTime)
+{
+	summary->processSequence->intervals[cpu->interval].end = currentTime;
+	cpu->activeProcess = -1;
+}
+
+static int step_cpu(Cpu *cpus, CpuHeap *heaps, int index, const Process *processes, RunState *state, AdmissionIndex *admission, Info *summary, int *cpuOf,
+					int currentTime, Algorithm algo, const SimConfig *config)
+{
+	Cpu *cpu = &cpus[index];
+	int active = cpu->activeProcess, finished = 0;
+
+	if(active != -1)														// The running process ran through every tick since the CPU was last looked at
+		state->timeRemaining[active] -= currentTime - cpu->lastTick;
+	cpu->lastTick = currentTime + 1;
+
+	if(is_queue_empty(cpu->readyQueue) && (active == -1 || state->timeRemaining[active] <= 0))	// About to go idle; steal the next process of the longest ready queue
+	{
+		int victim = heaps[QUEUE_HEAP].order[0];
+
+		if(victim != index && !is_queue_empty(cpus[victim].readyQueue))
+		{
+			int ID = dequeue_process(cpus[victim].readyQueue);
+
+			if(algo == CFS)													// Its weight moves along, and its virtual runtime keeps its lead over the least
+			{
+				cpus[victim].readyQueue->totalWeight -= cfs_weight(processes[ID].priority);
+				cpu->readyQueue->totalWeight += cfs_weight(processes[ID].priority);
+				state->vruntime[ID] += cpu->readyQueue->minVruntime - cpus[victim].readyQueue->minVruntime;
+			}
+
+			enqueue_on_cpu(cpu, processes, state, ID, algo, currentTime);
+			summary->migrations++;
+			fix_cpu(heaps, victim);
+		}
+	}
+
+	if(active == -1 && !is_queue_empty(cpu->readyQueue))					// Loading a process onto an idle CPU
+		load_process(cpu, index, processes, state, summary, cpuOf, currentTime);
+
+	else if(active != -1 && state->timeRemaining[active] <= 0)				// Finishing a process, loading the next one if there is one
+	{
+		state->status[active] = TERMINATED;
+		state->endTime[active] = currentTime;
+		record_finished_process(summary, active, currentTime - processes[active].arrivalTime, processes[active].burstTime);
+		if(algo == CFS)
+			cpu->readyQueue->totalWeight -= cfs_weight(processes[active].priority);
+		finished++;
+		stop_process(cpu, summary, currentTime);
+
+		if(!is_queue_empty(cpu->readyQueue))
+			load_process(cpu, index, processes, state, summary, cpuOf, currentTime);
+	}
+
+	else if(active != -1 && !is_queue_empty(cpu->readyQueue) &&
+			((algo == STCF && state->timeRemaining[active] > state->timeRemaining[peek_queue(cpu->readyQueue)]) ||
+			 (algo == RR && currentTime - state->lastStart[active] >= config->quantum) ||
+			 (algo == CFS && cfs_preempts(cpu->readyQueue, cfs_vruntime(state->vruntime[active], processes[active].burstTime - state->timeRemaining[active], cfs_weight(processes[active].priority)),
+										  cfs_weight(processes[active].priority), currentTime - state->lastStart[active]))))	// STCF, round robin or CFS preemption; the process goes back into this CPU's queue next tick
+	{
+		state->status[active] = WAITING;
+		add_waiting_process(admission, active);
+		stop_process(cpu, summary, currentTime);
+		load_process(cpu, index, processes, state, summary, cpuOf, currentTime);
+	}
+
+	else if(active != -1)													// Simple process execution
+		state->timeRemaining[active]--;
+
+	cpu->eventTime = INT_MAX;												// Next tick the CPU has to be looked at if nothing is added to its queue
+
+	if(cpu->activeProcess != -1)
+	{
+		cpu->eventTime = currentTime + 1 + MAX(state->timeRemaining[cpu->activeProcess], 0);
+
+		if(algo == RR && !is_queue_empty(cpu->readyQueue))
+			cpu->eventTime = MIN(cpu->eventTime, MAX(currentTime + 1, state->lastStart[cpu->activeProcess] + config->quantum));
+
+		if(algo == CFS && !is_queue_empty(cpu->readyQueue))
+			cpu->eventTime = MIN(cpu->eventTime, cfs_preempt_time(cpu->readyQueue, state->vruntime[cpu->activeProcess], processes[cpu->activeProcess].burstTime - state->timeRemaining[cpu->activeProcess],
+																  cfs_weight(processes[cpu->activeProcess].priority), state->lastStart[cpu->activeProcess], currentTime));
+	}
+
+	fix_cpu(heaps, index);
+
+	return finished;
+}
+
+Info* simulate_smp(FILE *outFile, const Process *processes, int numOfProcesses, Algorithm algo, const SimConfig *config)
+{
+	int numOfCpus = config->numOfCpus, currentTime = 0, processesComplete = 0;
+	Info *summary = make_info(numOfProcesses);
+	RunState *state = make_run_state(processes, numOfProcesses);
+	AdmissionIndex *admission = make_admission_index(processes, numOfProcesses);
+	int *cpuOf = (int *) malloc(sizeof(int) * (numOfProcesses + 1));			// CPU each process last ran on
+	Cpu *cpus = (Cpu *) malloc(sizeof(Cpu) * numOfCpus);
+	CpuHeap heaps[3];
+
+	summary->numOfCpus = numOfCpus;
+
+	if(outFile != NULL)														// Same title as the single CPU simulation; there is no interval trace
+		fprintf(outFile, "***** %s Scheduling *****\n", algorithm_name(algo));
+
+	for(int i = 0; i < numOfCpus; i++)
+	{
+		if(algo == CFS)
+			cpus[i].readyQueue = make_tree_queue();
+		else
+			cpus[i].readyQueue = SORTED_QUEUE_TYPE == HEAP_QUEUE && (algo == SJF || algo == STCF || algo == NPP) ? make_heap_queue() : make_queue();
+		cpus[i].activeProcess = -1;
+		cpus[i].lastTick = 0;
+		cpus[i].eventTime = INT_MAX;
+		cpus[i].interval = -1;
+	}
+
+	for(int type = EVENT_HEAP; type <= QUEUE_HEAP; type++)
+		init_cpu_heap(&heaps[type], type, cpus, numOfCpus);
+
+	while(processesComplete < numOfProcesses)
+	{
+		int nextTime;
+
+		begin_admissions(admission, processes, currentTime);
+
+		for(int i = next_admission(admission); i != -1; i = next_admission(admission))	// New processes go to the least loaded CPU, preempted ones back to their own
+		{
+			int target = state->status[i] == WAITING ? cpuOf[i] : heaps[LOAD_HEAP].order[0];
+			int idle = heaps[LOAD_HEAP].order[0];
+
+			enqueue_on_cpu(&cpus[target], processes, state, i, algo, currentTime);
+			cpus[target].eventTime = currentTime;							// Look at the CPU this tick, in case the new process takes over
+			fix_cpu(heaps, target);
+
+			if(idle != target && cpu_load(&cpus[idle]) == 0)				// Wake an idle CPU to steal a process left waiting
+			{
+				cpus[idle].eventTime = currentTime;
+				fix_cpu(heaps, idle);
+			}
+		}
+
+		while(cpus[heaps[EVENT_HEAP].order[0]].eventTime <= currentTime)		// Only the CPUs with something to do this tick
+			processesComplete += step_cpu(cpus, heaps, heaps[EVENT_HEAP].order[0], processes, state, admission, summary, cpuOf, currentTime, algo, config);
+
+		if(processesComplete == numOfProcesses)
+			break;
+
+		nextTime = MIN(next_arrival_time(admission, processes), cpus[heaps[EVENT_HEAP].order[0]].eventTime);	// Jump straight to the next tick where something can change
+
+		if(admission->numWaiting > 0 || nextTime == INT_MAX)				// Preempted processes return on the very next tick
+			nextTime = currentTime + 1;
+
+		currentTime = nextTime;
+	}
+
+	summary->avgTurnaroundTime /= numOfProcesses;							// Wait and turnaround times were summed up as each process finished
+	summary->avgWaitTime /= numOfProcesses;
+	summary->endTime = currentTime;
+
+	for(int i = 0; i < numOfCpus; i++)
+	{
+		summary->nodeRequests += cpus[i].readyQueue->nodePool.requests;
+		summary->allocations += cpus[i].readyQueue->nodePool.allocations + cpus[i].readyQueue->heapAllocations;
+		destroy_queue(cpus[i].readyQueue);
+	}
+	summary->allocations += summary->processSequence->allocations;
+
+	for(int type = EVENT_HEAP; type <= QUEUE_HEAP; type++)
+		free(heaps[type].order);
+
+	free(cpus);
+	free(cpuOf);
+	destroy_admission_index(admission);
+	destroy_run_state(state);
+
+	return summary;
+}
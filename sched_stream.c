@@ -0,0 +1,415 @@
+/*************************************************************************************
+File Name: sched_stream.c
+
+Objective: Simulate every CPU scheduling algorithm while the input is still being read,
+		   keeping only the processes that have not finished yet, so workloads of any
+		   size can be simulated in a fixed amount of memory
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+static void init_stream_sim(StreamSim *sim, Algorithm algo, const SimConfig *config)
+{
+	sim->algo = algo;
+	sim->config = *config;
+	if(algo == CFS)
+		sim->readyQueue = make_tree_queue();
+	else
+		sim->readyQueue = SORTED_QUEUE_TYPE == HEAP_QUEUE && (algo == SJF || algo == STCF || algo == NPP) ? make_heap_queue() : make_queue();
+	sim->capacity = 64;														// Grown as needed; never more than the most processes live at once
+	sim->slots = (StreamSlot *) malloc(sizeof(StreamSlot) * sim->capacity);
+	sim->freeSlots = (int *) malloc(sizeof(int) * sim->capacity);
+	sim->arrivals = (int *) malloc(sizeof(int) * sim->capacity);
+	sim->numFree = 0;
+	sim->numLive = 0;
+	sim->peakLive = 0;
+	sim->firstArrival = 0;
+	sim->numArrivals = 0;
+	sim->activeSlot = -1;
+	sim->waitingSlot = -1;
+	sim->currentTime = 0;
+	sim->lastTick = 0;
+	sim->eventTime = INT_MAX;
+	sim->endTime = 0;
+	sim->numDone = 0;
+	sim->contextSwitches = 0;
+	init_latency_stats(&sim->latency);
+}
+
+static int take_slot(StreamSim *sim)
+{
+	if(sim->numFree > 0)													// Reuse the slot of a finished process first
+		return sim->freeSlots[--sim->numFree];
+
+	if(sim->numLive == sim->capacity)										// Every slot is live; slots past numLive have never been used
+	{
+		sim->capacity *= 2;
+		sim->slots = (StreamSlot *) realloc(sim->slots, sizeof(StreamSlot) * sim->capacity);
+		sim->freeSlots = (int *) realloc(sim->freeSlots, sizeof(int) * sim->capacity);
+		sim->arrivals = (int *) realloc(sim->arrivals, sizeof(int) * sim->capacity);
+	}
+
+	return sim->numLive;
+}
+
+static void add_stream_process(StreamSim *sim, const Process *process)
+{
+	int slot = take_slot(sim);
+
+	sim->slots[slot].ID = process->ID;
+	sim->slots[slot].arrivalTime = process->arrivalTime;
+	sim->slots[slot].burstTime = process->burstTime;
+	sim->slots[slot].priority = process->priority;
+	sim->slots[slot].timeRemaining = process->burstTime;
+	sim->slots[slot].lastStart = 0;
+	sim->slots[slot].vruntime = 0;
+
+	sim->numLive++;
+	sim->peakLive = MAX(sim->peakLive, sim->numLive);
+
+	if(sim->firstArrival + sim->numArrivals == sim->capacity)				// Move the processes still to arrive back to the front
+	{
+		memmove(sim->arrivals, sim->arrivals + sim->firstArrival, sizeof(int) * sim->numArrivals);
+		sim->firstArrival = 0;
+	}
+
+	sim->arrivals[sim->firstArrival + sim->numArrivals++] = slot;
+}
+
+static long long slot_vruntime(const StreamSlot *slot, int ticksRun)
+{
+	return cfs_vruntime(slot->vruntime, ticksRun, cfs_weight(slot->priority));
+}
+
+static void admit_slot(StreamSim *sim, int slot, int currentTime)
+{
+	StreamSlot *process = &sim->slots[slot];
+
+	switch(sim->algo)														// Same ready queue order as the simulation of the whole input
+	{
+		case FCFS: case RR:
+			enqueue_process(sim->readyQueue, slot);
+			break;
+
+		case SJF:
+			sorted_enqueue_process(sim->readyQueue, slot, sim->slots[slot].burstTime);
+			break;
+
+		case STCF:
+			sorted_enqueue_process(sim->readyQueue, slot, sim->slots[slot].timeRemaining);
+			break;
+
+		case NPP:
+			sorted_enqueue_process(sim->readyQueue, slot, sim->slots[slot].priority);
+			break;
+
+		case CFS:
+			if(process->timeRemaining == process->burstTime)				// Arriving, since a preempted process has always run; the running process has run
+			{																// every tick since lastTick too
+				const StreamSlot *running = sim->activeSlot == -1 ? NULL : &sim->slots[sim->activeSlot];
+
+				process->vruntime = cfs_place(sim->readyQueue, running == NULL ? LLONG_MAX : slot_vruntime(running, running->burstTime - running->timeRemaining + currentTime - sim->lastTick));
+				sim->readyQueue->totalWeight += cfs_weight(process->priority);
+			}
+
+			tree_enqueue_process(sim->readyQueue, slot, slot_vruntime(process, process->burstTime - process->timeRemaining));
+			break;
+	}
+}
+
+static void admit_processes(StreamSim *sim, int currentTime)
+{
+	int waiting = sim->waitingSlot;
+
+	sim->waitingSlot = -1;
+
+	while(sim->numArrivals > 0 && sim->slots[sim->arrivals[sim->firstArrival]].arrivalTime == currentTime)	// Arrivals and the preempted process enter in ID order
+	{
+		int slot = sim->arrivals[sim->firstArrival];
+
+		if(waiting != -1 && sim->slots[waiting].ID < sim->slots[slot].ID)
+		{
+			admit_slot(sim, waiting, currentTime);
+			waiting = -1;
+		}
+
+		admit_slot(sim, slot, currentTime);
+		sim->firstArrival++;
+		sim->numArrivals--;
+	}
+
+	if(waiting != -1)
+		admit_slot(sim, waiting, currentTime);
+
+	if(sim->numArrivals == 0)
+		sim->firstArrival = 0;
+}
+
+static void load_slot(StreamSim *sim, int currentTime)
+{
+	int slot = dequeue_process(sim->readyQueue);
+
+	sim->activeSlot = slot;
+
+	if(sim->slots[slot].timeRemaining == sim->slots[slot].burstTime)		// First time the process runs
+		record_value(&sim->latency.response, currentTime - sim->slots[slot].arrivalTime);
+
+	sim->slots[slot].lastStart = currentTime;
+	sim->slots[slot].timeRemaining--;										// Runs for the current tick
+	sim->contextSwitches++;
+}
+
+static void retire_slot(StreamSim *sim, int slot, int currentTime)
+{
+	int turnaroundTime = currentTime - sim->slots[slot].arrivalTime;
+
+	record_value(&sim->latency.turnaround, turnaroundTime);					// Only the histograms are kept; the slot is free for the next process
+	record_value(&sim->latency.wait, turnaroundTime - sim->slots[slot].burstTime);
+	sim->numDone++;
+	sim->endTime = currentTime;
+
+	if(sim->algo == CFS)
+		sim->readyQueue->totalWeight -= cfs_weight(sim->slots[slot].priority);
+
+	sim->freeSlots[sim->numFree++] = slot;
+	sim->numLive--;
+	sim->activeSlot = -1;
+}
+
+static void step_stream_sim(StreamSim *sim, int currentTime)
+{
+	int active = sim->activeSlot;
+
+	if(active != -1)														// The running process ran through every tick since the CPU was last looked at
+		sim->slots[active].timeRemaining -= currentTime - sim->lastTick;
+	sim->lastTick = currentTime + 1;
+
+	if(active == -1 && !is_queue_empty(sim->readyQueue))					// Loading a process onto an idle CPU
+		load_slot(sim, currentTime);
+
+	else if(active != -1 && sim->slots[active].timeRemaining <= 0)			// Finishing a process, loading the next one if there is one
+	{
+		retire_slot(sim, active, currentTime);
+
+		if(!is_queue_empty(sim->readyQueue))
+			load_slot(sim, currentTime);
+	}
+
+	else if(active != -1 && !is_queue_empty(sim->readyQueue) &&
+			((sim->algo == STCF && sim->slots[active].timeRemaining > sim->slots[peek_queue(sim->readyQueue)].timeRemaining) ||
+			 (sim->algo == RR && currentTime - sim->slots[active].lastStart >= sim->config.quantum) ||
+			 (sim->algo == CFS && cfs_preempts(sim->readyQueue, slot_vruntime(&sim->slots[active], sim->slots[active].burstTime - sim->slots[active].timeRemaining),
+											   cfs_weight(sim->slots[active].priority), currentTime - sim->slots[active].lastStart))))	// STCF, round robin or CFS preemption; the process goes back into the ready queue next tick
+	{
+		sim->waitingSlot = active;
+		load_slot(sim, currentTime);
+	}
+
+	else if(active != -1)													// Simple process execution
+		sim->slots[active].timeRemaining--;
+
+	sim->eventTime = INT_MAX;
+
+	if(sim->activeSlot != -1)
+	{
+		StreamSlot *running = &sim->slots[sim->activeSlot];
+
+		sim->eventTime = currentTime + 1 + MAX(running->timeRemaining, 0);
+
+		if(sim->algo == RR && !is_queue_empty(sim->readyQueue))
+			sim->eventTime = MIN(sim->eventTime, MAX(currentTime + 1, running->lastStart + sim->config.quantum));
+
+		if(sim->algo == CFS && !is_queue_empty(sim->readyQueue))
+			sim->eventTime = MIN(sim->eventTime, cfs_preempt_time(sim->readyQueue, running->vruntime, running->burstTime - running->timeRemaining, cfs_weight(running->priority),
+																  running->lastStart, currentTime));
+	}
+}
+
+static void advance_stream_sim(StreamSim *sim, int limit)
+{
+	while(true)																// Only the ticks where something can change, up to (not including) limit
+	{
+		int nextTime = sim->waitingSlot != -1 ? sim->currentTime : sim->eventTime;
+
+		if(sim->numArrivals > 0)
+			nextTime = MIN(nextTime, sim->slots[sim->arrivals[sim->firstArrival]].arrivalTime);
+
+		if(nextTime >= limit)
+			break;
+
+		admit_processes(sim, nextTime);
+		step_stream_sim(sim, nextTime);
+		sim->currentTime = nextTime + 1;
+	}
+
+	sim->currentTime = MAX(sim->currentTime, limit);
+}
+
+static void print_stream_report(Stream *stream)
+{
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+	{
+		StreamSim *sim = &stream->sims[i];
+
+		fprintf(stream->outFile, "%d\t%s\t%lld\t%d\t%.2f\t%.2f\t%d\t%d\n", stream->nextReport, algorithm_name(i), sim->numDone, sim->numLive,
+				sim->latency.wait.sum / MAX(sim->numDone, 1), sim->latency.turnaround.sum / MAX(sim->numDone, 1),
+				histogram_percentile(&sim->latency.wait, 99), histogram_percentile(&sim->latency.turnaround, 99));
+	}
+
+	fflush(stream->outFile);												// Reports are meant to be read while the stream is still running
+}
+
+static void advance_stream(Stream *stream, int limit)
+{
+	while(stream->reportPeriod > 0 && stream->nextReport <= limit && stream->nextReport < INT_MAX)	// Every report time passed on the way
+	{
+		for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+			advance_stream_sim(&stream->sims[i], stream->nextReport);
+
+		print_stream_report(stream);
+		stream->nextReport = stream->nextReport > INT_MAX - stream->reportPeriod ? INT_MAX : stream->nextReport + stream->reportPeriod;
+	}
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+		advance_stream_sim(&stream->sims[i], limit);
+}
+
+static bool stream_live(Stream *stream)
+{
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+		if(stream->sims[i].numLive > 0)
+			return true;
+
+	return false;
+}
+
+Stream* make_stream(FILE *outFile, int reportPeriod, const SimConfig *config)
+{
+	Stream *stream = (Stream *) malloc(sizeof(Stream));
+
+	stream->outFile = outFile;
+	stream->sims = (StreamSim *) malloc(sizeof(StreamSim) * NUM_OF_ALGORITHMS);
+	stream->reportPeriod = MAX(reportPeriod, 0);
+	stream->nextReport = stream->reportPeriod > 0 ? stream->reportPeriod : INT_MAX;
+	stream->lastArrival = 0;
+	stream->numOfProcesses = 0;
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+		init_stream_sim(&stream->sims[i], i, config);
+
+	fprintf(outFile, "***** STREAMING SIMULATION *****\n\n");
+
+	if(stream->reportPeriod > 0)											// Running averages of the processes finished before each report time
+		fprintf(outFile, "Time\tAlgorithm\tDone\tLive\tAvg WT\tAvg TT\tp99 WT\tp99 TT\n");
+
+	return stream;
+}
+
+bool stream_process(Stream *stream, const Process *process)
+{
+	if(process->arrivalTime < stream->lastArrival)							// Everything before the last arrival may already be simulated
+		return false;
+
+	advance_stream(stream, process->arrivalTime);							// Every algorithm is simulated up to the arrival before the process is added
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+		add_stream_process(&stream->sims[i], process);
+
+	stream->lastArrival = process->arrivalTime;
+	stream->numOfProcesses++;
+
+	return true;
+}
+
+void finish_stream(Stream *stream)
+{
+	while(stream->reportPeriod > 0 && stream->nextReport < INT_MAX && stream_live(stream))	// Keep reporting until the last process finishes
+		advance_stream(stream, stream->nextReport);
+
+	stream->nextReport = INT_MAX;											// Every process has finished, so no report is left to print
+	advance_stream(stream, INT_MAX);
+
+	fprintf(stream->outFile, "\n***** STREAMING SUMMARY *****\n\n");
+	fprintf(stream->outFile, "Processes: %lld\n\n", stream->numOfProcesses);
+	fprintf(stream->outFile, "Algorithm\tAvg WT\t\tAvg TT\t\tContext Switches\tPeak Live\tEnd Time\n");
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+	{
+		StreamSim *sim = &stream->sims[i];
+
+		fprintf(stream->outFile, "%-12s\t%-12.2f\t%-12.2f\t%-16lld\t%-9d\t%d\n", algorithm_name(i), sim->latency.wait.sum / MAX(sim->numDone, 1),
+				sim->latency.turnaround.sum / MAX(sim->numDone, 1), sim->contextSwitches, sim->peakLive, sim->endTime);
+	}
+
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)								// Tail latencies, from the histograms rather than every process
+	{
+		fprintf(stream->outFile, "\n%s\n", algorithm_name(i));
+		print_latency_stats(stream->outFile, &stream->sims[i].latency);
+	}
+}
+
+void destroy_stream(Stream *stream)
+{
+	for(int i = 0; i < NUM_OF_ALGORITHMS; i++)
+	{
+		destroy_queue(stream->sims[i].readyQueue);
+		free(stream->sims[i].slots);
+		free(stream->sims[i].freeSlots);
+		free(stream->sims[i].arrivals);
+	}
+
+	free(stream->sims);
+	free(stream);
+}
+
+static bool take_parsed_processes(Stream *stream, ParseState *state)
+{
+	for(int i = 0; i < state->numOfProcesses; i++)
+		if(!stream_process(stream, &state->processes[i]))
+			return false;
+
+	if(state->field != 0)													// Keep the process still being read at the front
+		state->processes[0] = state->processes[state->numOfProcesses];
+
+	state->firstID += state->numOfProcesses;								// The processes array is reused for the next piece
+	state->numOfProcesses = 0;
+
+	return true;
+}
+
+long long stream_file(Stream *stream, const char *fileName)
+{
+	ParseState state = { NULL, 0, 0, 0, 0, false, false, 0, 0 };
+	int fd = strcmp(fileName, "-") == 0 ? STDIN_FILENO : open(fileName, O_RDONLY);	// "-" reads the processes from standard input
+	char *buffer;
+	ssize_t length;
+	bool ordered = true;
+
+	if(fd < 0)
+		return -1;
+
+	buffer = (char *) malloc(STREAM_BUFFER_SIZE);
+
+	while(ordered && (length = read(fd, buffer, STREAM_BUFFER_SIZE)) > 0)	// Each piece is simulated before the next is read
+	{
+		parse_processes(&state, buffer, length);
+		ordered = take_parsed_processes(stream, &state);
+	}
+
+	if(ordered && state.inNumber)											// The last number may end at the end of the file
+	{
+		parse_processes(&state, "\n", 1);
+		ordered = take_parsed_processes(stream, &state);
+	}
+
+	if(fd != STDIN_FILENO)
+		close(fd);
+
+	free(buffer);
+	free(state.processes);
+
+	return ordered ? stream->numOfProcesses : -2;
+}
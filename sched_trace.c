@@ -0,0 +1,731 @@
+/*************************************************************************************
+File Name: sched_trace.c
+
+Objective: Provide the functions that print the interval trace of a CPU scheduling
+		   simulation, either directly or from a background writer thread, and that
+		   write and render its compact binary form
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+static void* run_trace_writer(void *arg);
+
+static void append_text(Tracer *tracer, const char *text);
+
+Tracer* make_tracer(FILE *outFile, int interval, bool async)
+{
+	Tracer *tracer = (Tracer *) malloc(sizeof(Tracer));
+
+	tracer->outFile = outFile;
+	tracer->interval = interval;
+	tracer->fromTime = 0;
+	tracer->toTime = INT_MAX;
+	tracer->sampleEvery = 1;
+	tracer->sampleCount = 0;
+	tracer->changesOnly = false;
+	tracer->async = async;
+	tracer->binary = false;
+	tracer->lastTime = 0;
+	tracer->callback = NULL;
+	tracer->callbackContext = NULL;
+	tracer->textCapacity = TRACE_TEXT_SIZE + 4096;						// Room to finish the line being formatted when the text is written out
+	tracer->text = (char *) malloc(tracer->textCapacity);
+	tracer->textLength = 0;
+	tracer->ids = NULL;
+	tracer->idsCapacity = 0;
+	tracer->bytesWritten = 0;
+	INSTRUMENT(tracer->cycles = 0; tracer->queueCycles = 0;)
+
+	tracer->ring = NULL;
+	tracer->ringHead = tracer->ringPublished = tracer->ringTail = tracer->ringTailSeen = 0;
+	tracer->finished = false;
+	tracer->replica = NULL;
+
+	if(async)															// The writer thread formats from a ring of records and its own copy of the ready queue
+	{
+		tracer->ring = (TraceRecord *) malloc(sizeof(TraceRecord) * TRACE_RING_SIZE);
+		tracer->replica = make_queue();
+		pthread_mutex_init(&tracer->lock, NULL);
+		pthread_cond_init(&tracer->notEmpty, NULL);
+		pthread_cond_init(&tracer->notFull, NULL);
+		pthread_create(&tracer->writer, NULL, run_trace_writer, tracer);
+	}
+
+	return tracer;
+}
+
+Tracer* make_binary_tracer(FILE *traceFile, Algorithm algo)
+{
+	Tracer *tracer = make_tracer(traceFile, 1, false);
+
+	tracer->binary = true;
+
+	tracer->text[tracer->textLength++] = BEGIN_RECORD;					// Every algorithm's trace starts with a header, so traces can simply be concatenated
+	append_text(tracer, "STRC");
+	tracer->text[tracer->textLength++] = TRACE_FORMAT_VERSION;
+	tracer->text[tracer->textLength++] = algo;
+
+	return tracer;
+}
+
+Tracer* make_callback_tracer(TraceCallback callback, void *context)
+{
+	Tracer *tracer = make_tracer(NULL, 1, false);						// Nothing is written, so there is no file
+
+	tracer->callback = callback;
+	tracer->callbackContext = context;
+
+	return tracer;
+}
+
+void init_trace_sampling(TraceSampling *sampling)
+{
+	sampling->off = false;
+	sampling->every = 1;
+	sampling->changesOnly = false;
+	sampling->fromTime = 0;
+	sampling->toTime = INT_MAX;
+}
+
+bool parse_trace_sampling(const char *text, TraceSampling *sampling)
+{
+	char *copy = strdup(text), *save, *setting;
+	bool valid = true;
+
+	for(setting = strtok_r(copy, ",", &save); setting != NULL && valid; setting = strtok_r(NULL, ",", &save))
+	{
+		if(strcmp(setting, "off") == 0)
+			sampling->off = true;
+		else if(strcmp(setting, "changes") == 0)
+			sampling->changesOnly = true;
+		else if(strncmp(setting, "every=", 6) == 0)
+			valid = (sampling->every = atoi(setting + 6)) > 0;
+		else if(strncmp(setting, "window=", 7) == 0)						// Both ends are included
+			valid = sscanf(setting + 7, "%d:%d", &sampling->fromTime, &sampling->toTime) == 2 && sampling->fromTime >= 0 && sampling->toTime >= sampling->fromTime;
+		else
+			valid = false;
+	}
+
+	free(copy);
+
+	return valid;
+}
+
+void sample_tracer(Tracer *tracer, const TraceSampling *sampling)
+{
+	tracer->sampleEvery = sampling->every;
+	tracer->changesOnly = sampling->changesOnly;
+	tracer->fromTime = sampling->fromTime;
+	tracer->toTime = sampling->toTime;
+}
+
+static void write_text(Tracer *tracer)
+{
+	fwrite(tracer->text, 1, tracer->textLength, tracer->outFile);		// Text is written out in large blocks rather than a line at a time
+	tracer->bytesWritten += tracer->textLength;
+	tracer->textLength = 0;
+}
+
+static void append_text(Tracer *tracer, const char *text)
+{
+	while(*text != '\0')
+		tracer->text[tracer->textLength++] = *text++;
+}
+
+static void append_int(Tracer *tracer, int value)
+{
+	char digits[12];
+	int count = 0;
+	unsigned int magnitude = value < 0 ? -(unsigned int) value : (unsigned int) value;
+
+	if(value < 0)
+		tracer->text[tracer->textLength++] = '-';
+
+	do																	// Digits come out backwards, so collect them first
+	{
+		digits[count++] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while(magnitude > 0);
+
+	while(count > 0)
+		tracer->text[tracer->textLength++] = digits[--count];
+}
+
+static void append_ids(Tracer *tracer, int *ids, int count)
+{
+	if(count == 0)														// Same format as print_queue
+	{
+		append_text(tracer, "Empty\n");
+		return;
+	}
+
+	for(int i = 0; i < count; i++)
+	{
+		if(tracer->textLength > TRACE_TEXT_SIZE)						// Long queues may need writing out part way through
+			write_text(tracer);
+
+		if(i > 0)
+			tracer->text[tracer->textLength++] = '-';
+		append_int(tracer, ids[i]);
+	}
+
+	tracer->text[tracer->textLength++] = '\n';
+}
+
+static void append_queue(Tracer *tracer, Queue *queue)
+{
+	INSTRUMENT(unsigned long long start = read_cycles();)
+
+	if(queue->length > tracer->idsCapacity)								// Grow the scratch space only when the queue has outgrown it
+	{
+		tracer->idsCapacity = MAX(queue->length, 2 * tracer->idsCapacity);
+		tracer->ids = (int *) realloc(tracer->ids, sizeof(int) * tracer->idsCapacity);
+	}
+
+	append_ids(tracer, tracer->ids, queue_contents(queue, tracer->ids));
+	INSTRUMENT(tracer->queueCycles += read_cycles() - start;)
+}
+
+static void append_varint(Tracer *tracer, int value)
+{
+	unsigned int bits = ((unsigned int) value << 1) ^ -(unsigned int) (value < 0);	// Zigzag encoding keeps small negative numbers short too
+
+	while(bits >= 0x80)													// Seven bits per byte, high bit set on every byte but the last
+	{
+		tracer->text[tracer->textLength++] = (char) (bits | 0x80);
+		bits >>= 7;
+	}
+
+	tracer->text[tracer->textLength++] = (char) bits;
+}
+
+static void encode_record(Tracer *tracer, TraceRecord *record)
+{
+	if(tracer->textLength > TRACE_TEXT_SIZE)
+		write_text(tracer);
+
+	tracer->text[tracer->textLength++] = (char) record->type;
+
+	if(record->type <= RUN_RECORD)										// What the CPU did is stored relative to the previous record's time
+	{
+		append_varint(tracer, record->time - tracer->lastTime);
+		tracer->lastTime = record->time;
+	}
+
+	switch(record->type)												// Only the fields the record type prints are stored
+	{
+		case LOAD_RECORD:
+			append_varint(tracer, record->nextProcess);
+			append_varint(tracer, record->nextValue);
+			break;
+
+		case IDLE_RECORD:
+			append_varint(tracer, record->endTime - record->time);
+			break;
+
+		case FINISH_LOAD_RECORD:
+			append_varint(tracer, record->process);
+			append_varint(tracer, record->nextProcess);
+			append_varint(tracer, record->nextValue);
+			break;
+
+		case FINISH_RECORD:
+			append_varint(tracer, record->process);
+			break;
+
+		case PREEMPT_RECORD:
+			append_varint(tracer, record->process);
+			append_varint(tracer, record->value);
+			append_varint(tracer, record->nextProcess);
+			append_varint(tracer, record->nextValue);
+			break;
+
+		case RUN_RECORD:
+			append_varint(tracer, record->endTime - record->time);
+			append_varint(tracer, record->process);
+			append_varint(tracer, record->value);
+			break;
+
+		case ENQUEUE_RECORD:
+			append_varint(tracer, record->process);
+			break;
+
+		case SORTED_ENQUEUE_RECORD: case INSERT_RECORD:
+			append_varint(tracer, record->process);
+			append_varint(tracer, record->value);
+			break;
+	}
+}
+
+static void format_tick(Tracer *tracer, TraceRecord *record, int time, Queue *queue)
+{
+	if(tracer->textLength > TRACE_TEXT_SIZE)
+		write_text(tracer);
+
+	append_text(tracer, "t = ");										// Same text the simulation has always printed for a tick
+	append_int(tracer, time);
+	append_text(tracer, "\nCPU: ");
+
+	switch(record->type)
+	{
+		case LOAD_RECORD:
+			append_text(tracer, "Loading Process ");
+			append_int(tracer, record->nextProcess);
+			append_text(tracer, " (CPU Burst = ");
+			append_int(tracer, record->nextValue);
+			append_text(tracer, ")\n");
+			break;
+
+		case IDLE_RECORD:
+			append_text(tracer, "Idle, Waiting for a Process\n");
+			break;
+
+		case FINISH_LOAD_RECORD:
+			append_text(tracer, "Finishing Process ");
+			append_int(tracer, record->process);
+			append_text(tracer, "; Loading Process ");
+			append_int(tracer, record->nextProcess);
+			append_text(tracer, " (CPU Burst = ");
+			append_int(tracer, record->nextValue);
+			append_text(tracer, ")\n");
+			break;
+
+		case FINISH_RECORD:
+			append_text(tracer, "Finishing Process ");
+			append_int(tracer, record->process);
+			append_text(tracer, "\n");
+			break;
+
+		case PREEMPT_RECORD:
+			append_text(tracer, "Preempting Process ");
+			append_int(tracer, record->process);
+			append_text(tracer, " (Remaining CPU Burst = ");
+			append_int(tracer, record->value);
+			append_text(tracer, "); Loading Process ");
+			append_int(tracer, record->nextProcess);
+			append_text(tracer, " (CPU Burst = ");
+			append_int(tracer, record->nextValue);
+			append_text(tracer, ")\n");
+			break;
+
+		case RUN_RECORD:
+			append_text(tracer, "Running Process ");
+			append_int(tracer, record->process);
+			append_text(tracer, " (Remaining CPU Burst = ");
+			append_int(tracer, record->value - (time - record->time));	// Spans of running ticks count the burst down from their first tick
+			append_text(tracer, ")\n");
+			break;
+	}
+
+	append_text(tracer, "Ready Queue: ");
+	append_queue(tracer, queue);
+	append_text(tracer, "\n");
+}
+
+static long long first_tick(Tracer *tracer, TraceRecord *record)
+{
+	long long from = MAX(record->time, tracer->fromTime);
+
+	return (from + tracer->interval - 1) / tracer->interval * tracer->interval;	// First tick of the record that falls on an interval
+}
+
+static long long end_tick(Tracer *tracer, TraceRecord *record)
+{
+	return MIN(record->endTime, (long long) tracer->toTime + 1);
+}
+
+static void format_record(Tracer *tracer, TraceRecord *record, Queue *queue)
+{
+	for(long long t = first_tick(tracer, record); t < end_tick(tracer, record); t += tracer->interval)	// Every tick of a span that falls on an interval; single ticks are spans of one
+		format_tick(tracer, record, (int) t, queue);
+}
+
+static void publish_records(Tracer *tracer)
+{
+	pthread_mutex_lock(&tracer->lock);
+	tracer->ringPublished = tracer->ringHead;							// Hand every record written so far to the writer
+	tracer->ringTailSeen = tracer->ringTail;
+	pthread_cond_signal(&tracer->notEmpty);
+	pthread_mutex_unlock(&tracer->lock);
+}
+
+static void push_record(Tracer *tracer, TraceRecord *record)
+{
+	if(tracer->ringHead - tracer->ringTailSeen == TRACE_RING_SIZE)		// Ring looks full; wait for the writer to make room
+	{
+		publish_records(tracer);
+
+		pthread_mutex_lock(&tracer->lock);
+		while(tracer->ringHead - tracer->ringTail == TRACE_RING_SIZE)
+			pthread_cond_wait(&tracer->notFull, &tracer->lock);
+		tracer->ringTailSeen = tracer->ringTail;
+		pthread_mutex_unlock(&tracer->lock);
+	}
+
+	tracer->ring[tracer->ringHead % TRACE_RING_SIZE] = *record;
+	tracer->ringHead++;
+
+	if(tracer->ringHead - tracer->ringPublished >= TRACE_BATCH_SIZE)		// Records are handed over in batches to keep locking rare
+		publish_records(tracer);
+}
+
+static void* run_trace_writer(void *arg)
+{
+	Tracer *tracer = (Tracer *) arg;
+	unsigned long long end;
+
+	while(true)
+	{
+		pthread_mutex_lock(&tracer->lock);
+		while(tracer->ringPublished == tracer->ringTail && !tracer->finished)
+			pthread_cond_wait(&tracer->notEmpty, &tracer->lock);
+		end = tracer->ringPublished;
+		pthread_mutex_unlock(&tracer->lock);
+
+		if(end == tracer->ringTail)										// Finished and nothing left to format
+			break;
+
+		for(unsigned long long i = tracer->ringTail; i < end; i++)		// Replay queue changes on the copy of the ready queue and format the ticks
+		{
+			TraceRecord *record = &tracer->ring[i % TRACE_RING_SIZE];
+
+			switch(record->type)
+			{
+				case ENQUEUE_RECORD:
+					enqueue_process(tracer->replica, record->process);
+					break;
+
+				case SORTED_ENQUEUE_RECORD:
+					sorted_enqueue_process(tracer->replica, record->process, record->value);
+					break;
+
+				case INSERT_RECORD:
+					insert_process(tracer->replica, record->process, record->value);
+					break;
+
+				case DEQUEUE_RECORD:
+					dequeue_process(tracer->replica);
+					break;
+
+				default:
+					format_record(tracer, record, tracer->replica);
+			}
+		}
+
+		pthread_mutex_lock(&tracer->lock);
+		tracer->ringTail = end;
+		pthread_cond_signal(&tracer->notFull);
+		pthread_mutex_unlock(&tracer->lock);
+	}
+
+	write_text(tracer);
+
+	return NULL;
+}
+
+void trace_enqueue(Tracer *tracer, int ID, int key, bool sorted)
+{
+	TraceRecord record = { sorted ? SORTED_ENQUEUE_RECORD : ENQUEUE_RECORD, 0, 0, ID, key, 0, 0 };
+	INSTRUMENT(unsigned long long start = read_cycles();)
+
+	if(tracer->callback != NULL)
+		tracer->callback(tracer->callbackContext, &record);
+	else if(tracer->async)													// Only the writer thread's copy of the ready queue needs to hear about changes
+		push_record(tracer, &record);
+	else if(tracer->binary)
+		encode_record(tracer, &record);
+
+	INSTRUMENT(tracer->cycles += read_cycles() - start;)
+}
+
+void trace_insert(Tracer *tracer, int ID, int position)
+{
+	TraceRecord record = { INSERT_RECORD, 0, 0, ID, position, 0, 0 };	// Tree queue keys are too wide for a record; the position is all a copy needs
+	INSTRUMENT(unsigned long long start = read_cycles();)
+
+	if(tracer->callback != NULL)
+		tracer->callback(tracer->callbackContext, &record);
+	else if(tracer->async)
+		push_record(tracer, &record);
+	else if(tracer->binary)
+		encode_record(tracer, &record);
+
+	INSTRUMENT(tracer->cycles += read_cycles() - start;)
+}
+
+void trace_dequeue(Tracer *tracer)
+{
+	TraceRecord record = { DEQUEUE_RECORD, 0, 0, 0, 0, 0, 0 };
+	INSTRUMENT(unsigned long long start = read_cycles();)
+
+	if(tracer->callback != NULL)
+		tracer->callback(tracer->callbackContext, &record);
+	else if(tracer->async)
+		push_record(tracer, &record);
+	else if(tracer->binary)
+		encode_record(tracer, &record);
+
+	INSTRUMENT(tracer->cycles += read_cycles() - start;)
+}
+
+static void keep_span(Tracer *tracer, RecordType type, int fromTime, int toTime, int process, int value, int nextProcess, int nextValue, Queue *readyQueue)
+{
+	TraceRecord record = { type, fromTime, toTime, process, value, nextProcess, nextValue };
+
+	if(toTime <= fromTime || toTime <= tracer->fromTime || fromTime > tracer->toTime)	// Empty, or outside the time window
+		return;
+
+	if(tracer->changesOnly && (type == RUN_RECORD || type == IDLE_RECORD))
+		return;
+
+	if(tracer->sampleEvery > 1 && tracer->sampleCount++ % tracer->sampleEvery != 0)	// Sampled spans are counted after every other filter
+		return;
+
+	if(tracer->callback != NULL)										// Callbacks get every record kept, whatever the interval
+	{
+		tracer->callback(tracer->callbackContext, &record);
+		return;
+	}
+
+	if(tracer->binary)													// Binary traces keep every record kept so any interval can be rendered later
+	{
+		encode_record(tracer, &record);
+		return;
+	}
+
+	if(tracer->interval <= 0 || first_tick(tracer, &record) >= end_tick(tracer, &record))
+		return;															// Nothing to print unless a tick of the span falls on an interval
+
+	if(tracer->async)													// Asynchronous tracers only copy the record; the writer thread formats it
+		push_record(tracer, &record);
+	else
+		format_record(tracer, &record, readyQueue);
+}
+
+void trace_span(Tracer *tracer, RecordType type, int fromTime, int toTime, int process, int value, int nextProcess, int nextValue, Queue *readyQueue)
+{
+	INSTRUMENT(unsigned long long start = read_cycles();)
+
+	keep_span(tracer, type, fromTime, toTime, process, value, nextProcess, nextValue, readyQueue);	// Sampled and formatted, or dropped
+
+	INSTRUMENT(tracer->cycles += read_cycles() - start;)
+}
+
+void destroy_tracer(Tracer *tracer)
+{
+	if(tracer->async)													// Let the writer thread format everything left before stopping it
+	{
+		publish_records(tracer);
+
+		pthread_mutex_lock(&tracer->lock);
+		tracer->finished = true;
+		pthread_cond_signal(&tracer->notEmpty);
+		pthread_mutex_unlock(&tracer->lock);
+
+		pthread_join(tracer->writer, NULL);
+
+		pthread_mutex_destroy(&tracer->lock);
+		pthread_cond_destroy(&tracer->notEmpty);
+		pthread_cond_destroy(&tracer->notFull);
+		destroy_queue(tracer->replica);
+		free(tracer->ring);
+	}
+	else if(tracer->callback == NULL)
+		write_text(tracer);
+
+	free(tracer->text);
+	free(tracer->ids);
+
+	free(tracer);														// Destroy/deallocate the memory reserved for the tracer
+	tracer = NULL;
+}
+
+static int read_byte(TraceReader *reader)
+{
+	if(reader->position == reader->length)								// Refill the block once it has all been read
+	{
+		reader->length = fread(reader->data, 1, READ_BUFFER_SIZE, reader->inFile);
+		reader->position = 0;
+
+		if(reader->length == 0)
+			return EOF;
+	}
+
+	return reader->data[reader->position++];
+}
+
+static bool read_varint(TraceReader *reader, int *value)
+{
+	unsigned int bits = 0;
+	int byte;
+
+	for(int shift = 0; shift < 35; shift += 7)							// Undo append_varint; a number never takes more than five bytes
+	{
+		if((byte = read_byte(reader)) == EOF)
+			return false;
+
+		bits |= (unsigned int) (byte & 0x7F) << shift;
+
+		if((byte & 0x80) == 0)
+		{
+			*value = (int) (bits >> 1) ^ -(int) (bits & 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static bool read_record(TraceReader *reader, TraceRecord *record, int *lastTime)
+{
+	int delta = 0, length = 1;
+	bool valid = true;
+
+	record->process = record->nextProcess = -1;
+	record->value = record->nextValue = 0;
+
+	if(record->type <= RUN_RECORD)										// Undo encode_record field by field
+	{
+		valid = read_varint(reader, &delta);
+		record->time = *lastTime += delta;
+	}
+
+	switch(record->type)
+	{
+		case LOAD_RECORD:
+			valid = valid && read_varint(reader, &record->nextProcess) && read_varint(reader, &record->nextValue);
+			break;
+
+		case IDLE_RECORD:
+			valid = valid && read_varint(reader, &length);
+			break;
+
+		case FINISH_LOAD_RECORD:
+			valid = valid && read_varint(reader, &record->process) && read_varint(reader, &record->nextProcess) && read_varint(reader, &record->nextValue);
+			break;
+
+		case FINISH_RECORD:
+			valid = valid && read_varint(reader, &record->process);
+			break;
+
+		case PREEMPT_RECORD:
+			valid = valid && read_varint(reader, &record->process) && read_varint(reader, &record->value) && read_varint(reader, &record->nextProcess) && read_varint(reader, &record->nextValue);
+			break;
+
+		case RUN_RECORD:
+			valid = valid && read_varint(reader, &length) && read_varint(reader, &record->process) && read_varint(reader, &record->value);
+			break;
+
+		case ENQUEUE_RECORD:
+			valid = read_varint(reader, &record->process);
+			break;
+
+		case SORTED_ENQUEUE_RECORD: case INSERT_RECORD:
+			valid = read_varint(reader, &record->process) && read_varint(reader, &record->value);
+			break;
+
+		case DEQUEUE_RECORD:
+			break;
+
+		default:
+			valid = false;
+	}
+
+	record->endTime = record->time + length;
+
+	return valid && length > 0;
+}
+
+static bool read_header(TraceReader *reader, Algorithm *algo)
+{
+	const char *tag = "STRC";
+
+	for(int i = 0; tag[i] != '\0'; i++)									// Same header make_binary_tracer writes
+		if(read_byte(reader) != tag[i])
+			return false;
+
+	if(read_byte(reader) != TRACE_FORMAT_VERSION)
+		return false;
+
+	*algo = read_byte(reader);
+
+	return *algo >= FCFS && *algo <= CFS;
+}
+
+bool render_trace(FILE *traceFile, FILE *outFile, int interval, int fromTime, int toTime)
+{
+	TraceReader reader = { traceFile, (unsigned char *) malloc(READ_BUFFER_SIZE), 0, 0 };
+	Tracer *tracer = make_tracer(outFile, interval, false);
+	Queue *replica = NULL;
+	TraceRecord record;
+	Algorithm algo;
+	int type, lastTime = 0;
+	bool valid = true;
+
+	tracer->fromTime = fromTime;
+	tracer->toTime = toTime;
+
+	while(valid && (type = read_byte(&reader)) != EOF)
+	{
+		if(type == BEGIN_RECORD)										// Next algorithm starts with an empty ready queue at time 0
+		{
+			if((valid = read_header(&reader, &algo)))
+			{
+				if(replica != NULL)
+					destroy_queue(replica);
+				replica = make_queue();
+				lastTime = 0;
+
+				if(tracer->textLength > TRACE_TEXT_SIZE)
+					write_text(tracer);
+				append_text(tracer, "***** ");							// Same title simulate prints
+				append_text(tracer, algorithm_name(algo));
+				append_text(tracer, " Scheduling *****\n");
+			}
+
+			continue;
+		}
+
+		record.type = type;
+		valid = replica != NULL && read_record(&reader, &record, &lastTime);
+
+		if(!valid)
+			break;
+
+		switch(type)													// Replay queue changes on the copy of the ready queue and format the ticks
+		{
+			case ENQUEUE_RECORD:
+				enqueue_process(replica, record.process);
+				break;
+
+			case SORTED_ENQUEUE_RECORD:
+				sorted_enqueue_process(replica, record.process, record.value);
+				break;
+
+			case INSERT_RECORD:
+				if((valid = record.value >= 0 && record.value <= replica->length))	// A corrupt position would index past the copy of the queue
+					insert_process(replica, record.process, record.value);
+				break;
+
+			case DEQUEUE_RECORD:
+				if((valid = !is_queue_empty(replica)))
+					dequeue_process(replica);
+				break;
+
+			default:
+				if(interval > 0)
+					format_record(tracer, &record, replica);
+		}
+	}
+
+	destroy_tracer(tracer);
+
+	if(replica != NULL)
+		destroy_queue(replica);
+	free(reader.data);
+
+	return valid;
+}
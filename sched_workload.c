@@ -0,0 +1,276 @@
+/*************************************************************************************
+File Name: sched_workload.c
+
+Objective: Provide the functions that generate seeded synthetic workloads for the CPU
+		   scheduling simulator, either in memory or written in the input file format
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+#define PARETO_SHAPE 1.5					// Heavy tail: the mean exists but the variance does not
+#define BURST_LENGTH 8						// Bursty values sit at the minimum this many draws at a time, on average
+
+void init_workload_spec(WorkloadSpec *spec, int numOfProcesses, unsigned long long seed)
+{
+	Distribution burstTime = { UNIFORM_DIST, 50.5, 1, 100 };
+	Distribution priority = { UNIFORM_DIST, 4.5, 0, 9 };
+	Distribution arrivalGap = { EXPONENTIAL_DIST, 50.5, 0, INT_MAX };		// Processes arrive about as fast as the CPU finishes them
+
+	spec->numOfProcesses = numOfProcesses;
+	spec->seed = seed;
+	spec->burstTime = burstTime;
+	spec->priority = priority;
+	spec->arrivalGap = arrivalGap;
+}
+
+static bool to_int(double value, int *result)
+{
+	if(!(value >= 0 && value <= INT_MAX))									// Input files have no negative numbers, and every number fits an int; NaN fails too
+		return false;
+
+	*result = (int) value;
+	return true;
+}
+
+bool parse_distribution(const char *text, Distribution *dist)
+{
+	double values[3];
+	int count = 0;
+	size_t nameLength = strcspn(text, ":");
+	const char *next = text + nameLength;
+	int min = 0, max = INT_MAX;
+
+	while(*next == ':' && count < 3)										// Up to three numbers follow the name
+	{
+		char *end;
+
+		values[count] = strtod(next + 1, &end);
+		if(end == next + 1)
+			return false;
+
+		count++;
+		next = end;
+	}
+
+	if(*next != '\0')
+		return false;
+
+	if(nameLength == 7 && strncmp(text, "uniform", 7) == 0)				// Uniform takes its range; everything else takes its mean first
+	{
+		if(count != 2 || !to_int(values[0], &min) || !to_int(values[1], &max) || min > max)
+			return false;
+
+		dist->type = UNIFORM_DIST;
+		dist->min = min;
+		dist->max = max;
+		dist->mean = (dist->min + dist->max) / 2.0;
+		return true;
+	}
+
+	if(nameLength == 3 && strncmp(text, "exp", 3) == 0)
+		dist->type = EXPONENTIAL_DIST;
+	else if(nameLength == 6 && strncmp(text, "pareto", 6) == 0)
+		dist->type = PARETO_DIST;
+	else if(nameLength == 6 && strncmp(text, "bursty", 6) == 0)
+		dist->type = BURSTY_DIST;
+	else
+		return false;
+
+	if(count == 0 || (count > 1 && !to_int(values[1], &min)) || (count > 2 && !to_int(values[2], &max)))
+		return false;
+
+	dist->mean = values[0];
+	dist->min = min;
+	dist->max = max;
+
+	return dist->mean >= min && dist->mean <= INT_MAX && max >= min;
+}
+
+bool parse_workload_spec(const char *text, WorkloadSpec *spec)
+{
+	char *copy = strdup(text), *save, *setting;
+	bool valid = true;
+
+	for(setting = strtok_r(copy, ",", &save); setting != NULL && valid; setting = strtok_r(NULL, ",", &save))
+	{
+		char *value = strchr(setting, '=');
+
+		if(value == NULL)
+		{
+			valid = false;
+			break;
+		}
+
+		*value++ = '\0';													// Split the setting into its name and value
+
+		if(strcmp(setting, "n") == 0)
+			valid = (spec->numOfProcesses = atoi(value)) > 0;
+		else if(strcmp(setting, "seed") == 0)
+		{
+			char *end;
+
+			errno = 0;
+			spec->seed = strtoull(value, &end, 10);
+			valid = isdigit((unsigned char) value[0]) && *end == '\0' && errno == 0;	// Digits only; strtoull alone reads anything else as 0
+		}
+		else if(strcmp(setting, "burst") == 0)
+			valid = parse_distribution(value, &spec->burstTime);
+		else if(strcmp(setting, "priority") == 0)
+			valid = parse_distribution(value, &spec->priority);
+		else if(strcmp(setting, "arrival") == 0)
+			valid = parse_distribution(value, &spec->arrivalGap);
+		else
+			valid = false;
+	}
+
+	free(copy);
+
+	return valid;
+}
+
+void init_workload_generator(WorkloadGenerator *generator, const WorkloadSpec *spec)
+{
+	generator->spec = *spec;
+	generator->random = spec->seed;
+	generator->nextID = 0;
+	generator->arrivalTime = 0;
+}
+
+static unsigned long long next_random(WorkloadGenerator *generator)
+{
+	unsigned long long bits = (generator->random += 0x9E3779B97F4A7C15ULL);	// SplitMix64: small, fast and the same on every platform
+
+	bits = (bits ^ (bits >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	bits = (bits ^ (bits >> 27)) * 0x94D049BB133111EBULL;
+
+	return bits ^ (bits >> 31);
+}
+
+static double random_fraction(WorkloadGenerator *generator)
+{
+	return ((next_random(generator) >> 11) + 1) * (1.0 / 9007199254740992.0);	// Uniform in (0, 1], so its logarithm is always finite
+}
+
+static int draw_value(WorkloadGenerator *generator, const Distribution *dist)
+{
+	double excess = dist->mean - dist->min;									// Average amount drawn above the minimum
+	double value = dist->min;
+
+	switch(dist->type)
+	{
+		case UNIFORM_DIST:
+			value = dist->min + floor((1 - random_fraction(generator)) * ((double) dist->max - dist->min + 1));
+			break;
+
+		case EXPONENTIAL_DIST:
+			value = dist->min - excess * log(random_fraction(generator));
+			break;
+
+		case PARETO_DIST:													// Lomax (shifted Pareto), scaled to the requested mean
+			value = dist->min + excess * (PARETO_SHAPE - 1) * (pow(random_fraction(generator), -1 / PARETO_SHAPE) - 1);
+			break;
+
+		case BURSTY_DIST:													// Mostly the minimum, now and then a large exponential jump
+			if(random_fraction(generator) <= 1.0 / BURST_LENGTH)
+				value = dist->min - excess * BURST_LENGTH * log(random_fraction(generator));
+			break;
+	}
+
+	value = floor(value + 0.5);
+
+	return value > dist->max ? dist->max : (int) value;
+}
+
+bool next_generated_process(WorkloadGenerator *generator, Process *process)
+{
+	if(generator->nextID >= generator->spec.numOfProcesses)
+		return false;
+
+	if(generator->nextID > 0)												// First process arrives at time 0, the rest one gap after another
+		generator->arrivalTime = MIN(generator->arrivalTime + draw_value(generator, &generator->spec.arrivalGap), INT_MAX);
+
+	process->ID = generator->nextID++;
+	process->burstTime = draw_value(generator, &generator->spec.burstTime);
+	process->priority = draw_value(generator, &generator->spec.priority);
+	process->arrivalTime = (int) generator->arrivalTime;
+
+	return true;
+}
+
+Process* generate_processes(const WorkloadSpec *spec, int *numOfProcesses)
+{
+	WorkloadGenerator generator;
+	Process *processes = (Process *) malloc(sizeof(Process) * spec->numOfProcesses);
+
+	if(processes == NULL)
+		return NULL;
+
+	init_workload_generator(&generator, spec);
+
+	*numOfProcesses = 0;
+	while(next_generated_process(&generator, &processes[*numOfProcesses]))
+		(*numOfProcesses)++;
+
+	return processes;
+}
+
+static size_t append_number(char *text, int value)
+{
+	char digits[12];
+	int count = 0;
+	size_t length = 0;
+	unsigned int magnitude = value < 0 ? -(unsigned int) value : (unsigned int) value;
+
+	if(value < 0)
+		text[length++] = '-';
+
+	do																		// Digits come out backwards, so collect them first
+	{
+		digits[count++] = '0' + magnitude % 10;
+		magnitude /= 10;
+	} while(magnitude > 0);
+
+	while(count > 0)
+		text[length++] = digits[--count];
+
+	return length;
+}
+
+long long write_workload(FILE *outFile, const WorkloadSpec *spec)
+{
+	WorkloadGenerator generator;
+	Process process;
+	char *text = (char *) malloc(READ_BUFFER_SIZE + 64);
+	size_t length = 0;
+	long long bytes = 0;
+
+	init_workload_generator(&generator, spec);
+
+	while(next_generated_process(&generator, &process))					// Same format as the input files: burst, priority and arrival per line
+	{
+		if(process.ID > 0)
+			text[length++] = '\n';											// No newline after the last process, as in the original input files
+
+		length += append_number(text + length, process.burstTime);
+		text[length++] = ' ';
+		length += append_number(text + length, process.priority);
+		text[length++] = ' ';
+		length += append_number(text + length, process.arrivalTime);
+
+		if(length > READ_BUFFER_SIZE)										// Written out in large blocks
+		{
+			fwrite(text, 1, length, outFile);
+			bytes += length;
+			length = 0;
+		}
+	}
+
+	fwrite(text, 1, length, outFile);
+	bytes += length;
+	free(text);
+
+	return bytes;
+}
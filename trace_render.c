@@ -0,0 +1,49 @@
+/*************************************************************************************
+File Name: trace_render.c
+
+Objective: Print a binary trace written by the CPU scheduling simulator as the usual
+		   interval trace, optionally limited to a range of time
+
+Created By: Kristopher Lowell
+Date Created: 10/17/2026
+*************************************************************************************/
+
+#include "sched_sim.h"
+
+int main(int argc, char* argv[])
+{
+	FILE *traceFile;
+	int interval, fromTime, toTime;
+	bool valid;
+
+	if(argc < 3)																// Simple detection if not enough command line arguments were sent
+	{
+		printf("Usage: %s <trace file> <interval> [from time] [to time]\n", argv[0]);
+		return 0;
+	}
+
+	traceFile = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");		// "-" reads the trace from standard input
+
+	if(traceFile == NULL)
+	{
+		printf("ERROR: Unable to read trace file %s.\n", argv[1]);
+		return 0;
+	}
+
+	interval = atoi(argv[2]);
+	fromTime = argc > 3 ? MAX(atoi(argv[3]), 0) : 0;							// Optional range of ticks to print, every tick by default
+	toTime = argc > 4 ? atoi(argv[4]) : INT_MAX;
+
+	valid = render_trace(traceFile, stdout, interval, fromTime, toTime);		// Rendered text goes to standard output
+
+	if(traceFile != stdin)
+		fclose(traceFile);
+
+	if(!valid)
+	{
+		fprintf(stderr, "ERROR: Trace file %s is malformed or truncated.\n", argv[1]);
+		return 1;
+	}
+
+	return 0;
+}